@@ -2,25 +2,21 @@
 #
 # Project created by QtCreator 2015-10-23T09:49:22
 #
+# core  - static library with the headless simulation
+# game  - the Asteroids application
+# bench - micro and macro benchmarks
+# tests - tests of the simulation core, run with make check
+#
 #-------------------------------------------------
 
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = Asteroids
-TEMPLATE = app
-
-
-SOURCES += main.cpp\
-        mainwindow.cpp \
-    asteroid.cpp
-
-HEADERS  += mainwindow.h \
-    asteroid.h
+TEMPLATE = subdirs
 
-FORMS    += mainwindow.ui \
-    outerspace.ui
+SUBDIRS += core \
+    game \
+    bench \
+    tests
 
-RESOURCES += \
-    res.qrc
+core.subdir = core
+game.file = game.pro
+bench.subdir = bench
+tests.subdir = tests
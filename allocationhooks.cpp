@@ -0,0 +1,57 @@
+/** @file allocationhooks.cpp
+ *  @brief This file contains the replacement of the global operator new and delete, which count every allocation
+ *         with count_allocation() and otherwise behave like the defaults. It is only built into the game, unless
+ *         it is built with CONFIG += no_count_allocations, so that the profiler can show the allocations of every frame.
+ */
+
+#include "alloccounter.h"
+
+#include <cstdlib>
+#include <new>
+
+void* operator new(std::size_t size) {
+    count_allocation();
+
+    void* p = std::malloc(size != 0 ? size : 1);
+    if(p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    count_allocation();
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
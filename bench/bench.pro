@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Micro and macro benchmarks of the game.
+# Run with --output FILE to write the results as JSON lines.
+#
+#-------------------------------------------------
+
+QT       += core gui widgets
+
+CONFIG   += c++14 console
+CONFIG   -= app_bundle
+
+TARGET = asteroids_bench
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += main.cpp \
+    benchmark.cpp \
+    ../boardwidget.cpp \
+    ../boardrenderer.cpp \
+    ../spritecache.cpp
+
+HEADERS += benchmark.h \
+    ../boardwidget.h \
+    ../boardrenderer.h \
+    ../spritecache.h
+
+RESOURCES += ../res.qrc
+
+include(../core/core.pri)
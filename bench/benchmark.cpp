@@ -0,0 +1,26 @@
+/** @file benchmark.cpp
+ *  @brief This file contains the definition of the Benchmark class.
+ */
+
+#include "benchmark.h"
+
+#include <iostream>
+
+/**
+ * @brief Benchmark::Benchmark constructs a benchmark runner
+ * @param out is where the JSON results are written
+ */
+Benchmark::Benchmark(std::ostream& out) : out(out) {
+}
+
+/**
+ * @brief Benchmark::report writes a result as JSON to the output and as text to standard error.
+ */
+void Benchmark::report(const std::string& name, size_t entities, size_t iterations, double seconds) {
+    double ns_per_op = seconds * 1e9 / iterations;
+
+    out << "{\"benchmark\": \"" << name << "\", \"entities\": " << entities
+        << ", \"iterations\": " << iterations << ", \"ns_per_op\": " << ns_per_op << "}" << std::endl;
+
+    std::cerr << name << " [" << entities << "]: " << ns_per_op << " ns/op" << std::endl;
+}
@@ -0,0 +1,60 @@
+/** @file benchmark.h
+ *  @brief Class declaration for the Benchmark class, which times a piece of code and writes the result
+ *         as one line of JSON.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief The Benchmark class runs the body of a benchmark with a growing number of iterations until the run
+ * takes at least MIN_TIME, then reports the time per iteration. Each result is written to the output as a
+ * JSON object on its own line, so results of different commits can be compared by a script.
+ */
+class Benchmark {
+public:
+    static const int MIN_TIME = 200;
+
+    explicit Benchmark(std::ostream& out);
+
+    template<typename Body>
+    void run(const std::string& name, size_t entities, Body body);
+
+private:
+    void report(const std::string& name, size_t entities, size_t iterations, double seconds);
+
+    std::ostream& out;
+};
+
+/**
+ * @brief Benchmark::run times a benchmark
+ * @param name is the name of the benchmark
+ * @param entities is the number of entities the body works on, reported with the result
+ * @param body is called once per iteration
+ */
+template<typename Body>
+void Benchmark::run(const std::string& name, size_t entities, Body body) {
+    size_t iterations = 1;
+
+    for(;;) {
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < iterations; ++i) {
+            body();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if(elapsed.count() * 1000 >= MIN_TIME) {
+            report(name, entities, iterations, elapsed.count());
+            return;
+        }
+
+        iterations *= 2;
+    }
+}
+
+#endif // BENCHMARK_H
@@ -0,0 +1,311 @@
+/** @file main.cpp
+ *  @brief Runs the benchmarks of the game: the asteroid step, projectile collision, asteroid collision, spawning,
+ *         saving and restoring a game, ship rotation and rendering a full frame or only the changed parts of a frame to an offscreen image. Results are written as JSON lines to standard output,
+ *         or to the file given with --output FILE.
+ */
+
+#include "benchmark.h"
+#include "asteroidfield.h"
+#include "asteroidkernel.h"
+#include "world.h"
+#include "rng.h"
+#include "boardwidget.h"
+#include "spritecache.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <QApplication>
+#include <QImage>
+
+/**
+ * @brief bench_step moves fields of 10^2 to 10^6 asteroids on a 4096 by 4096 gameboard by one 10 ms step, including
+ * the occupancy grid updates and the respawns, and times the bare kernels on the same data.
+ */
+static void bench_step(Benchmark& bench) {
+    for(size_t n = 100; n <= 1000000; n *= 10) {
+        AsteroidField field;
+        field.set_board(World::Settings::MAX_GRID_SIZE, World::Settings::MAX_GRID_SIZE);
+        field.set_speed(600, 10, 25);
+        field.reserve(n);
+
+        Rng rng(1);
+        for(size_t i = 0; i < n; ++i) {
+            field.spawn(rng);
+        }
+
+        AsteroidField::Bounds bounds;
+        bounds.max_x = World::Settings::MAX_GRID_SIZE - 1;
+        bounds.max_y = World::Settings::MAX_GRID_SIZE - 1;
+        bounds.ship_x = World::Settings::MAX_GRID_SIZE / 2;
+        bounds.ship_y = World::Settings::MAX_GRID_SIZE / 2;
+
+        std::vector<unsigned char> mask;
+        bench.run("asteroid_step", n, [&]() {
+            field.move(bounds, mask);
+            for(size_t i = 0; i < n; ++i) {
+                if(mask[i >> 3] & (1 << (i & 7))) {
+                    field.respawn(i, rng);
+                }
+            }
+        });
+
+        std::vector<int> fx(n), fy(n), x(n), y(n), xVel(n), yVel(n);
+        for(size_t i = 0; i < n; ++i) {
+            fx[i] = field.getFixedX(i);
+            fy[i] = field.getFixedY(i);
+            x[i] = field.getX(i);
+            y[i] = field.getY(i);
+            xVel[i] = field.getXvel(i);
+            yVel[i] = field.getYvel(i);
+        }
+        std::vector<unsigned char> respawn((n + 7) / 8), crossed((n + 7) / 8);
+
+        bench.run("asteroid_kernel_fixed", n, [&]() {
+            step_asteroids(fx.data(), fy.data(), x.data(), y.data(), xVel.data(), yVel.data(), n, bounds,
+                           respawn.data(), crossed.data());
+        });
+
+        bench.run("asteroid_kernel_generic", n, [&]() {
+            step_asteroids_generic(fx.data(), fy.data(), x.data(), y.data(), xVel.data(), yVel.data(), n, bounds,
+                                   respawn.data(), crossed.data());
+        });
+
+        bench.run("asteroid_kernel_scalar", n, [&]() {
+            step_asteroids_scalar(fx.data(), fy.data(), x.data(), y.data(), xVel.data(), yVel.data(), n, bounds,
+                                  respawn.data(), crossed.data());
+        });
+
+        if(avx2_supported()) {
+            bench.run("asteroid_kernel_avx2", n, [&]() {
+                step_asteroids_avx2(fx.data(), fy.data(), x.data(), y.data(), xVel.data(), yVel.data(), n, bounds,
+                                    respawn.data(), crossed.data());
+            });
+        }
+    }
+}
+
+/**
+ * @brief bench_collision moves the shots through fields of 10^2 to 10^6 asteroids, firing again whenever
+ * a shot hits an asteroid or leaves the gameboard. The 4096 by 4096 gameboard has a FixedBoard; the 4095 by 4095
+ * one is searched with the runtime sized fallback, for comparison.
+ */
+static void bench_collision(Benchmark& bench) {
+    const int sizes[] = { World::Settings::MAX_GRID_SIZE, World::Settings::MAX_GRID_SIZE - 1 };
+
+    for(int size : sizes) {
+        for(int n = 100; n <= 1000000; n *= 10) {
+            World::Settings settings;
+            settings.grid_width = size;
+            settings.grid_length = size;
+            settings.ship_x = size / 2;
+            settings.ship_y = size / 2;
+            settings.num_asteroids = n;
+            settings.seed = 1;
+
+            World world(settings);
+            bench.run(size == World::Settings::MAX_GRID_SIZE ? "projectile_collision" : "projectile_collision_generic", n, [&]() {
+                world.fire();
+                world.move_attack();
+            });
+        }
+    }
+}
+
+/**
+ * @brief bench_collide bounces the asteroids that touch in fields of 10^3 to 10^5 asteroids on a 4096 by 4096
+ * gameboard. The asteroids first move for ten seconds of game time, so they have spread from the edges.
+ */
+static void bench_collide(Benchmark& bench) {
+    for(size_t n = 1000; n <= 100000; n *= 10) {
+        AsteroidField field;
+        field.set_board(World::Settings::MAX_GRID_SIZE, World::Settings::MAX_GRID_SIZE);
+        field.set_speed(600, 10, 25);
+
+        Rng rng(1);
+        field.spawn_wave(n, rng);
+
+        AsteroidField::Bounds bounds;
+        bounds.max_x = World::Settings::MAX_GRID_SIZE - 1;
+        bounds.max_y = World::Settings::MAX_GRID_SIZE - 1;
+        bounds.ship_x = -1;
+        bounds.ship_y = -1;
+
+        std::vector<unsigned char> mask;
+        for(int step = 0; step < 1000; ++step) {
+            field.move(bounds, mask);
+            for(size_t i = 0; i < n; ++i) {
+                if(mask[i >> 3] & (1 << (i & 7))) {
+                    field.respawn(i, rng);
+                }
+            }
+        }
+
+        bench.run("asteroid_collide", n, [&]() {
+            field.collide();
+        });
+    }
+}
+
+/**
+ * @brief bench_spawn respawns asteroids of a field one at a time, and spawns waves of 10^4 and 10^5 asteroids on a
+ * 4096 by 4096 gameboard one by one and in a single batch.
+ */
+static void bench_spawn(Benchmark& bench) {
+    const size_t n = 1000;
+
+    AsteroidField field;
+    Rng rng(1);
+    for(size_t i = 0; i < n; ++i) {
+        field.spawn(rng);
+    }
+
+    size_t i = 0;
+    bench.run("spawn", n, [&]() {
+        field.respawn(i, rng);
+        i = (i + 1) % n;
+    });
+
+    for(size_t wave = 10000; wave <= 100000; wave *= 10) {
+        AsteroidField many;
+        many.set_board(World::Settings::MAX_GRID_SIZE, World::Settings::MAX_GRID_SIZE);
+        many.set_speed(600, 10, 25);
+
+        bench.run("spawn_one_by_one", wave, [&]() {
+            many.clear();
+            for(size_t j = 0; j < wave; ++j) {
+                many.spawn(rng);
+            }
+        });
+        bench.run("spawn_wave", wave, [&]() {
+            many.clear();
+            many.spawn_wave(wave, rng);
+        });
+    }
+}
+
+/**
+ * @brief bench_state saves and restores a whole game with 10^3 to 10^5 asteroids on a 4096 by 4096 gameboard.
+ */
+static void bench_state(Benchmark& bench) {
+    for(int n = 1000; n <= 100000; n *= 10) {
+        World::Settings settings;
+        settings.grid_width = World::Settings::MAX_GRID_SIZE;
+        settings.grid_length = World::Settings::MAX_GRID_SIZE;
+        settings.ship_x = World::Settings::MAX_GRID_SIZE / 2;
+        settings.ship_y = World::Settings::MAX_GRID_SIZE / 2;
+        settings.num_asteroids = n;
+        settings.seed = 1;
+        World world(settings);
+
+        std::vector<unsigned char> state;
+        world.save_state(state);
+
+        bench.run("state_save", n, [&]() {
+            world.save_state(state);
+        });
+        bench.run("state_restore", n, [&]() {
+            world.restore_state(state);
+        });
+    }
+}
+
+/**
+ * @brief bench_rotation turns the ship and looks up the sprite of its new orientation.
+ */
+static void bench_rotation(Benchmark& bench) {
+    World world;
+    const SpriteCache& sprites = SpriteCache::shared();
+    volatile qint64 sink = 0;
+
+    bench.run("ship_rotation", 1, [&]() {
+        world.rotate_right();
+        sink = sprites.ship(world.ship_rotation()).cacheKey();
+    });
+}
+
+/**
+ * @brief bench_render draws a full frame of the gameboard into an offscreen image, with 10^2 to 10^4 asteroids.
+ */
+static void bench_render(Benchmark& bench) {
+    for(int n = 100; n <= 10000; n *= 10) {
+        World::Settings settings;
+        settings.num_asteroids = n;
+        settings.seed = 1;
+        World world(settings);
+
+        Snapshot snapshot;
+        snapshot.capture(world, 23, 23, 0);
+
+        BoardWidget board;
+        board.resize(575, 575);
+        board.show_snapshot(&snapshot, world.elapsed());
+        QImage image(board.size(), QImage::Format_ARGB32_Premultiplied);
+
+        bench.run("render_frame", n, [&]() {
+            board.render(&image);
+        });
+    }
+}
+
+/**
+ * @brief bench_render_dirty draws only the parts of the gameboard that changed between two frames one asteroid step
+ * apart, on a board with the default number of asteroids, and the full frame for comparison.
+ */
+static void bench_render_dirty(Benchmark& bench) {
+    World::Settings settings;
+    settings.seed = 1;
+    World world(settings);
+
+    Snapshot frames[2];
+    frames[0].capture(world, 23, 23, 0);
+    world.step(settings.asteroid_step);
+    frames[1].capture(world, 23, 23, 1);
+
+    BoardWidget board;
+    board.resize(575, 575);
+    QImage image(board.size(), QImage::Format_ARGB32_Premultiplied);
+
+    size_t frame = 0;
+    board.show_snapshot(&frames[frame], frames[frame].elapsed);
+    bench.run("render_dirty", settings.num_asteroids, [&]() {
+        frame ^= 1;
+        QRegion dirty = board.show_snapshot(&frames[frame], frames[frame].elapsed);
+        board.render(&image, QPoint(), dirty);
+    });
+    bench.run("render_full", settings.num_asteroids, [&]() {
+        frame ^= 1;
+        board.show_snapshot(&frames[frame], frames[frame].elapsed);
+        board.render(&image);
+    });
+}
+
+int main(int argc, char *argv[])
+{
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication a(argc, argv);
+
+    std::ofstream file;
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(std::strcmp(argv[i], "--output") == 0) {
+            file.open(argv[i + 1]);
+        }
+    }
+
+    Benchmark bench(file.is_open() ? file : std::cout);
+
+    bench_step(bench);
+    bench_collision(bench);
+    bench_collide(bench);
+    bench_spawn(bench);
+    bench_state(bench);
+    bench_rotation(bench);
+    bench_render(bench);
+    bench_render_dirty(bench);
+
+    return 0;
+}
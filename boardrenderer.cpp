@@ -0,0 +1,211 @@
+/** @file boardrenderer.cpp
+ *  @brief This file contains the definition of the BoardRenderer class.
+ */
+
+#include "boardrenderer.h"
+
+#include <algorithm>
+
+#include <QPainter>
+#include <QFont>
+#include <QColor>
+#include <QRect>
+#include <QString>
+
+/**
+ * @brief BoardRenderer::BoardRenderer is the constructor for the BoardRenderer class.
+ * The renderer shows 23 by 23 tiles and has no size until set_size() is called.
+ */
+BoardRenderer::BoardRenderer() : tiles(SpriteCache::shared()) {
+    viewRows = 23;
+    viewCols = 23;
+}
+
+/**
+ * @brief BoardRenderer::set_view changes the number of tiles that are visible at once.
+ * @param rows is the number of visible rows
+ * @param cols is the number of visible columns
+ * @return true if the view changed, false if it already had that many tiles
+ */
+bool BoardRenderer::set_view(int rows, int cols) {
+    if(rows == viewRows && cols == viewCols) {
+        return false;
+    }
+
+    viewRows = rows;
+    viewCols = cols;
+    scale_sprites();
+    return true;
+}
+
+/**
+ * @brief BoardRenderer::set_size changes the size of the area the gameboard is drawn in and rescales the sprites.
+ * @param size is the size in pixels
+ */
+void BoardRenderer::set_size(const QSize& size) {
+    if(size == boardSize) {
+        return;
+    }
+
+    boardSize = size;
+    scale_sprites();
+}
+
+/**
+ * @brief BoardRenderer::size gets the size of the area the gameboard is drawn in
+ * @return the size in pixels
+ */
+const QSize& BoardRenderer::size() const {
+    return boardSize;
+}
+
+/**
+ * @brief BoardRenderer::render draws the viewport. The background is filled first,
+ * then the ship, the asteroids and the shots are drawn on top of it. Fragments are drawn smaller, in the middle of the
+ * tile a whole asteroid would cover.
+ * @param painter is the painter to draw with. It must cover at least size() pixels.
+ * @param snapshot is the snapshot to draw
+ * @param time is the game time to draw, in milliseconds. It is at least the time of the snapshot.
+ * @param overlay is the profiler whose timings are drawn on top of the gameboard, or null for no overlay
+ */
+void BoardRenderer::render(QPainter& painter, const Snapshot& snapshot, double time, const Profiler* overlay) const {
+    painter.fillRect(QRect(QPoint(0, 0), boardSize), Qt::black);
+
+    if(snapshot.rows == 0) {
+        return;
+    }
+
+    painter.drawPixmap(tile_position(snapshot, snapshot.ship_x, snapshot.ship_y), tiles.ship(snapshot.ship_rotation));
+
+    if(snapshot.over) {
+        return;
+    }
+
+    for(size_t i = 0; i < snapshot.asteroids.size(); ++i) {
+        const Snapshot::Body& body = snapshot.asteroids[i];
+        const QPixmap& asteroid = tiles.asteroid(body.level);
+        QPointF inset((tileSize.width() - asteroid.width()) / 2.0, (tileSize.height() - asteroid.height()) / 2.0);
+        painter.drawPixmap(slide_position(snapshot, body, snapshot.asteroids_moved_at, snapshot.asteroid_step, time) + inset, asteroid);
+    }
+
+    const QPixmap& attack = tiles.attack();
+    for(size_t i = 0; i < snapshot.shots.size(); ++i) {
+        painter.drawPixmap(slide_position(snapshot, snapshot.shots[i], snapshot.attack_moved_at, snapshot.attack_speed, time), attack);
+    }
+
+    if(overlay != nullptr) {
+        draw_overlay(painter, *overlay);
+    }
+}
+
+/**
+ * @brief BoardRenderer::layout lists the pixels a frame draws sprites into, in the order render() draws them.
+ * The ship comes first, then the asteroids and the shots. The background and the overlay are not listed.
+ * @param snapshot is the snapshot to draw
+ * @param time is the game time to draw, in milliseconds
+ * @param rects is cleared and filled with one rectangle per sprite
+ */
+void BoardRenderer::layout(const Snapshot& snapshot, double time, std::vector<QRect>& rects) const {
+    rects.clear();
+
+    if(snapshot.rows == 0) {
+        return;
+    }
+
+    rects.push_back(sprite_rect(tile_position(snapshot, snapshot.ship_x, snapshot.ship_y)));
+
+    if(snapshot.over) {
+        return;
+    }
+
+    for(size_t i = 0; i < snapshot.asteroids.size(); ++i) {
+        rects.push_back(sprite_rect(slide_position(snapshot, snapshot.asteroids[i], snapshot.asteroids_moved_at, snapshot.asteroid_step, time)));
+    }
+
+    for(size_t i = 0; i < snapshot.shots.size(); ++i) {
+        rects.push_back(sprite_rect(slide_position(snapshot, snapshot.shots[i], snapshot.attack_moved_at, snapshot.attack_speed, time)));
+    }
+}
+
+/**
+ * @brief BoardRenderer::draw_overlay draws the p50, p99 and max of every phase the profiler measures
+ * in the top left corner of the gameboard.
+ * @param painter is the painter of the gameboard
+ * @param profiler is the profiler whose timings are drawn
+ */
+void BoardRenderer::draw_overlay(QPainter& painter, const Profiler& profiler) const {
+    QFont font("monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPointSize(8);
+    painter.setFont(font);
+
+    QString text = QString::fromStdString(profiler.summary());
+    QRect box = painter.boundingRect(QRect(QPoint(0, 0), boardSize), Qt::AlignLeft | Qt::AlignTop, text);
+    box.adjust(-4, -4, 4, 4);
+    box.moveTo(4, 4);
+
+    painter.fillRect(box, QColor(0, 0, 0, 180));
+    painter.setPen(Qt::green);
+    painter.drawText(box.adjusted(4, 4, -4, -4), Qt::AlignLeft | Qt::AlignTop, text);
+}
+
+/**
+ * @brief BoardRenderer::scale_sprites scales every sprite to the size of a tile so that rendering
+ * never has to scale an image.
+ */
+void BoardRenderer::scale_sprites() {
+    if(boardSize.isEmpty()) {
+        return;
+    }
+
+    tileSize = QSize(boardSize.width() / viewCols, boardSize.height() / viewRows);
+    tiles = SpriteCache::shared().scaled(tileSize);
+}
+
+/**
+ * @brief BoardRenderer::tile_position converts a location on the gameboard to a location in the drawing area.
+ * The x coordinate is the row of the grid and the y coordinate is the column.
+ * @param snapshot is the snapshot whose viewport is drawn
+ * @param x is the row, which can be between two tiles
+ * @param y is the column, which can be between two tiles
+ * @return the top left corner of the tile
+ */
+QPointF BoardRenderer::tile_position(const Snapshot& snapshot, double x, double y) const {
+    return QPointF((y - snapshot.left) * tileSize.width(), (x - snapshot.top) * tileSize.height());
+}
+
+/**
+ * @brief BoardRenderer::sprite_rect finds the pixels a sprite covers. A sprite between two pixels covers both of them.
+ * @param position is the top left corner of the sprite
+ * @return the rectangle of pixels
+ */
+QRect BoardRenderer::sprite_rect(const QPointF& position) const {
+    return QRectF(position, QSizeF(tileSize)).toAlignedRect();
+}
+
+/**
+ * @brief BoardRenderer::slide_position finds where a body is drawn while it slides from its previous position into its
+ * current one. A body that has not moved since it appeared on the ship is drawn on its tile.
+ * @param snapshot is the snapshot whose viewport is drawn
+ * @param body is the body
+ * @param moved_at is the game time at which the body last moved
+ * @param period is the number of milliseconds between two moves of the body
+ * @param time is the game time to draw
+ * @return the top left corner of the body
+ */
+QPointF BoardRenderer::slide_position(const Snapshot& snapshot, const Snapshot::Body& body, long long moved_at, int period, double time) const {
+    const double ONE = AsteroidField::ONE_TILE;
+
+    // the corner of the tile the center is on
+    double x = (body.x - ONE / 2) / ONE;
+    double y = (body.y - ONE / 2) / ONE;
+
+    if((body.x >> AsteroidField::FRACTION_BITS) == snapshot.ship_x && (body.y >> AsteroidField::FRACTION_BITS) == snapshot.ship_y) {
+        return tile_position(snapshot, x, y);
+    }
+
+    double slide = std::max(1, std::min(period, (int)MAX_SLIDE_TIME));
+    double left = 1.0 - std::max(0.0, std::min(1.0, (time - moved_at) / slide));
+
+    return tile_position(snapshot, x - body.x_vel / ONE * left, y - body.y_vel / ONE * left);
+}
@@ -0,0 +1,62 @@
+/** @file boardrenderer.h
+ *  @brief Class declaration for the BoardRenderer class. The BoardRenderer draws a Snapshot of the gameboard
+ *         with any QPainter, so the same frame can go to the screen or into an image.
+ */
+
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include "snapshot.h"
+#include "spritecache.h"
+#include "profiler.h"
+
+#include <QSize>
+#include <QPointF>
+#include <QRect>
+
+#include <vector>
+
+class QPainter;
+
+/**
+ * @brief The BoardRenderer class draws the background, the ship, the asteroids and the shots of a Snapshot
+ * in a single QPainter pass. The shared sprites are scaled to the size of a tile once and reused for every frame.
+ * Only the viewport of the snapshot is drawn, so the cost of a frame does not depend on the size of the gameboard
+ * or on the number of asteroids.
+ *
+ * Frames are drawn at a game time that can be later than the snapshot. Each moving body slides from its previous
+ * position into its current one during the first MAX_SLIDE_TIME milliseconds after it moved, so the motion stays
+ * smooth however the ticks and the frames line up.
+ *
+ * layout() lists the rectangles a frame draws sprites into, so a widget can repaint only the parts of the board that
+ * changed between two frames.
+ */
+class BoardRenderer {
+public:
+    static const int MAX_SLIDE_TIME = 120;
+
+    BoardRenderer();
+
+    bool set_view(int rows, int cols);
+    void set_size(const QSize& size);
+    const QSize& size() const;
+
+    void render(QPainter& painter, const Snapshot& snapshot, double time, const Profiler* overlay = nullptr) const;
+    void layout(const Snapshot& snapshot, double time, std::vector<QRect>& rects) const;
+
+private:
+    void scale_sprites();
+    void draw_overlay(QPainter& painter, const Profiler& profiler) const;
+    QPointF tile_position(const Snapshot& snapshot, double x, double y) const;
+    QRect sprite_rect(const QPointF& position) const;
+    QPointF slide_position(const Snapshot& snapshot, const Snapshot::Body& body, long long moved_at, int period, double time) const;
+
+    int viewRows;
+    int viewCols;
+
+    QSize boardSize;
+    QSize tileSize;
+    SpriteCache tiles;
+};
+
+#endif // BOARDRENDERER_H
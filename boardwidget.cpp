@@ -0,0 +1,127 @@
+/** @file boardwidget.cpp
+ *  @brief This file contains the definition of the BoardWidget class.
+ */
+
+#include "boardwidget.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+
+/**
+ * @brief BoardWidget::BoardWidget is the constructor for the BoardWidget class.
+ * @param parent is a default parameter
+ */
+BoardWidget::BoardWidget(QWidget *parent) : QWidget(parent) {
+    snapshot = nullptr;
+    time = 0;
+    drawnRotation = 0;
+
+    profiler = nullptr;
+    showOverlay = false;
+
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+/**
+ * @brief BoardWidget::set_view changes the number of tiles that are visible at once.
+ * @param rows is the number of visible rows
+ * @param cols is the number of visible columns
+ */
+void BoardWidget::set_view(int rows, int cols) {
+    if(renderer.set_view(rows, cols)) {
+        update();
+    }
+}
+
+/**
+ * @brief BoardWidget::show_snapshot chooses what the next paint draws and schedules a repaint of the parts of the
+ * board that differ from the frame shown before. The ship is only repainted when it moved or turned. When a frame has
+ * more than MAX_DIRTY_RECTS sprites, or the timing overlay is shown, the whole board is repainted.
+ * @param snapshot is the snapshot to draw. It must stay unchanged until the next call, or be null to draw nothing.
+ * @param time is the game time to draw, in milliseconds
+ * @return the region that is repainted
+ */
+QRegion BoardWidget::show_snapshot(const Snapshot* snapshot, double time) {
+    bool shown = this->snapshot != nullptr;
+    this->snapshot = snapshot;
+    this->time = time;
+
+    if(snapshot == nullptr) {
+        drawn.clear();
+        update();
+        return QRegion(rect());
+    }
+
+    renderer.layout(*snapshot, time, drawing);
+
+    QRegion dirty;
+    if(!shown || showOverlay || drawn.size() + drawing.size() > MAX_DIRTY_RECTS) {
+        dirty = QRegion(rect());
+    } else {
+        size_t first = 0;
+        if(!drawn.empty() && !drawing.empty() && drawn[0] == drawing[0] && drawnRotation == snapshot->ship_rotation) {
+            first = 1;
+        }
+
+        for(size_t i = first; i < drawn.size(); ++i) {
+            dirty += drawn[i];
+        }
+        for(size_t i = first; i < drawing.size(); ++i) {
+            dirty += drawing[i];
+        }
+    }
+
+    drawn.swap(drawing);
+    drawnRotation = snapshot->ship_rotation;
+
+    if(!dirty.isEmpty()) {
+        update(dirty);
+    }
+    return dirty;
+}
+
+/**
+ * @brief BoardWidget::set_profiler makes the board time its painting and gives the overlay its numbers
+ * @param profiler is the profiler, or null to stop timing
+ */
+void BoardWidget::set_profiler(Profiler* profiler) {
+    this->profiler = profiler;
+}
+
+/**
+ * @brief BoardWidget::toggle_overlay shows or hides the timings of the profiler on top of the gameboard.
+ */
+void BoardWidget::toggle_overlay() {
+    showOverlay = !showOverlay;
+    update();
+}
+
+/**
+ * @brief BoardWidget::paintEvent draws the viewport with the renderer. The painter is clipped to the region
+ * that needs repainting, so the background and the sprites are only filled in where the board changed.
+ * Emits painted() once a snapshot has been drawn.
+ * @param e is the default parameter for the paintEvent function
+ */
+void BoardWidget::paintEvent(QPaintEvent* e) {
+    ScopedTimer timer(profiler, Profiler::PAINT);
+
+    QPainter painter(this);
+    painter.setClipRegion(e->region());
+    if(snapshot == nullptr) {
+        painter.fillRect(rect(), Qt::black);
+        return;
+    }
+    renderer.render(painter, *snapshot, time, showOverlay ? profiler : nullptr);
+
+    emit painted();
+}
+
+/**
+ * @brief BoardWidget::resizeEvent gives the renderer the new size of the board.
+ * @param e is the default parameter for the resizeEvent function
+ */
+void BoardWidget::resizeEvent(QResizeEvent* e) {
+    QWidget::resizeEvent(e);
+    renderer.set_size(size());
+}
@@ -0,0 +1,63 @@
+/** @file boardwidget.h
+ *  @brief Class declaration for the BoardWidget class. The BoardWidget draws the gameboard of a game.
+ */
+
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include "snapshot.h"
+#include "boardrenderer.h"
+#include "profiler.h"
+
+#include <QWidget>
+#include <QRegion>
+#include <QRect>
+
+#include <vector>
+
+class QPaintEvent;
+class QResizeEvent;
+
+/**
+ * @brief The BoardWidget class shows a Snapshot of the gameboard on screen. The drawing itself is done by a
+ * BoardRenderer, which can also draw the same frame into an image.
+ *
+ * Only the parts of the board that change between two frames are repainted: the pixels the sprites of the last
+ * frame covered, which go back to the background, and the pixels the sprites of the new frame cover. The repaint
+ * is scheduled with update(), so Qt merges the frames that arrive before the next paint into one.
+ */
+class BoardWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static const size_t MAX_DIRTY_RECTS = 256;
+
+    explicit BoardWidget(QWidget *parent = 0);
+    void set_view(int rows, int cols);
+    QRegion show_snapshot(const Snapshot* snapshot, double time);
+
+    void set_profiler(Profiler* profiler);
+    void toggle_overlay();
+
+signals:
+    void painted();
+
+protected:
+    void paintEvent(QPaintEvent* e);
+    void resizeEvent(QResizeEvent* e);
+
+private:
+    const Snapshot* snapshot;
+    double time;
+    BoardRenderer renderer;
+
+    std::vector<QRect> drawn;
+    std::vector<QRect> drawing;
+    size_t drawnRotation;
+
+    Profiler* profiler;
+    bool showOverlay;
+};
+
+#endif // BOARDWIDGET_H
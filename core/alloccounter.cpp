@@ -0,0 +1,27 @@
+/** @file alloccounter.cpp
+ *  @brief This file contains the counter of heap allocations. The core does not replace operator new itself; a
+ *         program that wants its allocations counted links in a replacement that calls count_allocation(), as the
+ *         game does with allocationhooks.cpp. In any other program the count stays at zero.
+ */
+
+#include "alloccounter.h"
+
+#include <atomic>
+
+static std::atomic<uint64_t> allocations(0);
+
+/**
+ * @brief allocation_count gets the number of heap allocations counted with count_allocation()
+ * @return the number of allocations since the process started
+ */
+uint64_t allocation_count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief count_allocation counts one heap allocation with a relaxed atomic. It allocates nothing and can be called
+ * from operator new, also before main().
+ */
+void count_allocation() {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+}
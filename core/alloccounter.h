@@ -0,0 +1,14 @@
+/** @file alloccounter.h
+ *  @brief Declares allocation_count() and count_allocation(). The game replaces the global operator new with one that
+ *         calls count_allocation(), so that the number of heap allocations can be watched per frame.
+ */
+
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <cstdint>
+
+uint64_t allocation_count();
+void count_allocation();
+
+#endif // ALLOCCOUNTER_H
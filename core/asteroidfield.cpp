@@ -0,0 +1,561 @@
+/** @file asteroidfield.cpp
+ *  @brief This file contains the definition of the AsteroidField class.
+ */
+
+#include "asteroidfield.h"
+#include "asteroidkernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief starting_tile picks the tile along one side of the gameboard on which an asteroid enters.
+ * Tiles near the middle of the side are the most likely; the spread grows with the length of the side
+ * and matches the original 23 tile board.
+ * @param n is the number of tiles along the side
+ * @param rng is the random number generator of the game
+ * @return a tile in [0, n)
+ */
+static int starting_tile(int n, Rng& rng) {
+    return std::abs((int)rng.normal((n - 1) / 2, n * 6.0 / 23)) % n;
+}
+
+/**
+ * @brief AsteroidField::AsteroidField constructs an empty field on the original 23 by 23 gameboard, whose
+ * asteroids move one whole tile each step.
+ */
+AsteroidField::AsteroidField() {
+    set_board(23, 23);
+    set_speed(1, 1, 0);
+}
+
+/**
+ * @brief AsteroidField::set_board changes the size of the gameboard that the occupancy grid covers.
+ * Every asteroid is indexed again.
+ * @param rows is the number of rows of the gameboard
+ * @param cols is the number of columns of the gameboard
+ */
+void AsteroidField::set_board(int rows, int cols) {
+    this->rows = rows;
+    this->cols = cols;
+
+    grid.resize(rows, cols);
+    grid.rebuild(x.data(), y.data(), x.size());
+}
+
+/**
+ * @brief AsteroidField::set_speed changes the speed given to the asteroids that spawn from now on.
+ * The speed of each asteroid is drawn uniformly within spread percent of the average speed, and never exceeds
+ * one tile per step, so an asteroid cannot skip a tile.
+ * @param tile_time is the average number of milliseconds an asteroid takes to cross a tile
+ * @param step is the number of milliseconds between two moves
+ * @param spread is the largest difference from the average speed, in percent
+ */
+void AsteroidField::set_speed(int tile_time, int step, int spread) {
+    speed = (int)std::max(1LL, std::min((long long)ONE_TILE, (long long)ONE_TILE * step / std::max(1, tile_time)));
+    speedSpread = std::max(0, std::min(spread, 100));
+}
+
+/**
+ * @brief AsteroidField::size gets the number of asteroids in the field
+ * @return the number of asteroids
+ */
+size_t AsteroidField::size() const {
+    return x.size();
+}
+
+/**
+ * @brief AsteroidField::clear removes every asteroid from the field. The storage is kept, so the next game
+ * reuses it and only allocates once it has more asteroids than any game before it.
+ */
+void AsteroidField::clear() {
+    fx.clear();
+    fy.clear();
+    x.clear();
+    y.clear();
+    xVel.clear();
+    yVel.clear();
+    level.clear();
+    grid.clear();
+}
+
+/**
+ * @brief AsteroidField::reserve makes room for n asteroids so that spawning them does not reallocate.
+ * @param n is the number of asteroids
+ */
+void AsteroidField::reserve(size_t n) {
+    fx.reserve(n);
+    fy.reserve(n);
+    x.reserve(n);
+    y.reserve(n);
+    xVel.reserve(n);
+    yVel.reserve(n);
+    level.reserve(n);
+}
+
+/**
+ * @brief AsteroidField::spawn adds an asteroid to the field and gives it its initial location and velocity.
+ * @param rng is the random number generator of the game
+ * @return the index of the new asteroid
+ */
+size_t AsteroidField::spawn(Rng& rng) {
+    return spawn_wave(1, rng);
+}
+
+/**
+ * @brief AsteroidField::spawn_wave adds n asteroids to the field at once. Every array grows a single time, the
+ * asteroids are placed one after the other straight into it and are indexed by the occupancy grid last, so a wave
+ * of tens of thousands of asteroids costs one allocation at most. The random numbers are drawn in the same order
+ * as n calls to spawn() would draw them, so a game plays out the same either way.
+ * @param n is the number of asteroids
+ * @param rng is the random number generator of the game
+ * @return the index of the first new asteroid; the others follow it
+ */
+size_t AsteroidField::spawn_wave(size_t n, Rng& rng) {
+    size_t first = x.size();
+    size_t end = first + n;
+
+    fx.resize(end);
+    fy.resize(end);
+    x.resize(end);
+    y.resize(end);
+    xVel.resize(end);
+    yVel.resize(end);
+    level.resize(end);
+
+    for(size_t i = first; i < end; ++i) {
+        place(i, rng);
+    }
+    for(size_t i = first; i < end; ++i) {
+        grid.insert(x[i], y[i], (int)i);
+    }
+
+    return first;
+}
+
+/**
+ * @brief AsteroidField::respawn sets the initial location, direction of motion
+ * and speed for an asteroid. This function is called when an asteroid is created
+ * and when its location needs to be reset (after colliding with an attack).
+ * The occupancy grid is updated.
+ * @param i is the index of the asteroid
+ * @param rng is the random number generator of the game
+ */
+void AsteroidField::respawn(size_t i, Rng& rng) {
+    grid.remove(x[i], y[i], (int)i);
+    place(i, rng);
+    grid.insert(x[i], y[i], (int)i);
+}
+
+/**
+ * @brief AsteroidField::place picks the side an asteroid enters from, its tile along that side, its direction of
+ * motion and its speed. The asteroid starts whole, in the center of its tile. The occupancy grid is not touched.
+ * @param i is the index of the asteroid
+ * @param rng is the random number generator of the game
+ */
+void AsteroidField::place(size_t i, Rng& rng) {
+    int x_dir = 0;
+    int y_dir = 0;
+
+    int side = rng.uniform(1, 4);
+    switch(side) {
+    case(1): {
+        // top of grid
+        x[i] = 0;
+        y[i] = starting_tile(cols, rng);
+
+        x_dir = 1;
+        y_dir = rng.uniform(-1, 1);
+
+        break;
+    }
+    case(2): {
+        // left of grid
+        x[i] = starting_tile(rows, rng);
+        y[i] = 0;
+
+        x_dir = rng.uniform(-1, 1);
+        y_dir = 1;
+
+        break;
+    }
+    case(3): {
+        // bottom of grid
+        x[i] = rows - 1;
+        y[i] = starting_tile(cols, rng);
+
+        x_dir = -1;
+        y_dir = rng.uniform(-1, 1);
+
+        break;
+    }
+    case(4): {
+        // right of grid
+        x[i] = starting_tile(rows, rng);
+        y[i] = cols - 1;
+
+        x_dir = rng.uniform(-1, 1);
+        y_dir = -1;
+
+        break;
+    }
+    }
+
+    int v = speed;
+    if(speedSpread != 0) {
+        v = (int)std::max(1LL, std::min((long long)ONE_TILE, (long long)speed * (100 + rng.uniform(-speedSpread, speedSpread)) / 100));
+    }
+
+    fx[i] = x[i] * ONE_TILE + ONE_TILE / 2;
+    fy[i] = y[i] * ONE_TILE + ONE_TILE / 2;
+    xVel[i] = x_dir * v;
+    yVel[i] = y_dir * v;
+    level[i] = 0;
+}
+
+/**
+ * @brief AsteroidField::spawn_fragments breaks an asteroid into fragments one level higher. The fragments start at
+ * the center of the asteroid and fly apart in directions an equal number of eighths of a turn from each other,
+ * half again as fast as the asteroid but never more than a tile per step. The asteroid itself is left as it is.
+ * @param i is the index of the asteroid
+ * @param count is the number of fragments, at most MAX_FRAGMENTS
+ * @param rng is the random number generator of the game
+ * @return the index of the first fragment; the others follow it
+ */
+size_t AsteroidField::spawn_fragments(size_t i, int count, Rng& rng) {
+    static const int DIRECTIONS[MAX_FRAGMENTS][2] = {
+        { -1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, -1 }
+    };
+
+    size_t first = x.size();
+    size_t end = first + count;
+
+    fx.resize(end);
+    fy.resize(end);
+    x.resize(end);
+    y.resize(end);
+    xVel.resize(end);
+    yVel.resize(end);
+    level.resize(end);
+
+    int v = std::max(std::abs(xVel[i]), std::abs(yVel[i]));
+    v = std::min((int)ONE_TILE, std::max(speed, v) * 3 / 2);
+    int start = rng.uniform(0, MAX_FRAGMENTS - 1);
+
+    for(size_t j = first; j < end; ++j) {
+        const int* direction = DIRECTIONS[(start + (j - first) * MAX_FRAGMENTS / count) % MAX_FRAGMENTS];
+        fx[j] = fx[i];
+        fy[j] = fy[i];
+        x[j] = x[i];
+        y[j] = y[i];
+        xVel[j] = direction[0] * v;
+        yVel[j] = direction[1] * v;
+        level[j] = level[i] + 1;
+        grid.insert(x[j], y[j], (int)j);
+    }
+
+    return first;
+}
+
+/**
+ * @brief AsteroidField::remove takes an asteroid out of the field. The last asteroid takes its index, so removing
+ * costs the same however many asteroids there are. Remove asteroids from the highest index down to keep the
+ * indices of the ones still to remove.
+ * @param i is the index of the asteroid
+ */
+void AsteroidField::remove(size_t i) {
+    size_t last = x.size() - 1;
+
+    grid.remove(x[i], y[i], (int)i);
+    if(i != last) {
+        grid.remove(x[last], y[last], (int)last);
+        fx[i] = fx[last];
+        fy[i] = fy[last];
+        x[i] = x[last];
+        y[i] = y[last];
+        xVel[i] = xVel[last];
+        yVel[i] = yVel[last];
+        level[i] = level[last];
+        grid.insert(x[i], y[i], (int)i);
+    }
+
+    fx.pop_back();
+    fy.pop_back();
+    x.pop_back();
+    y.pop_back();
+    xVel.pop_back();
+    yVel.pop_back();
+    level.pop_back();
+}
+
+/**
+ * @brief AsteroidField::getX gets the x coordinate of an asteroid
+ * @param i is the index of the asteroid
+ * @return the x coordinate
+ */
+int AsteroidField::getX(size_t i) const {
+    return x[i];
+}
+
+/**
+ * @brief AsteroidField::getY gets the y coordinate of an asteroid
+ * @param i is the index of the asteroid
+ * @return the y coordinate
+ */
+int AsteroidField::getY(size_t i) const {
+    return y[i];
+}
+
+/**
+ * @brief AsteroidField::getFixedX gets the row of the center of an asteroid, in fixed point
+ * @param i is the index of the asteroid
+ * @return the row times ONE_TILE
+ */
+int AsteroidField::getFixedX(size_t i) const {
+    return fx[i];
+}
+
+/**
+ * @brief AsteroidField::getFixedY gets the column of the center of an asteroid, in fixed point
+ * @param i is the index of the asteroid
+ * @return the column times ONE_TILE
+ */
+int AsteroidField::getFixedY(size_t i) const {
+    return fy[i];
+}
+
+/**
+ * @brief AsteroidField::getXvel gets the distance an asteroid moves along the x-axis each step, in fixed point
+ * @param i is the index of the asteroid
+ * @return the velocity, at most ONE_TILE either way
+ */
+int AsteroidField::getXvel(size_t i) const {
+    return xVel[i];
+}
+
+/**
+ * @brief AsteroidField::getYvel gets the distance an asteroid moves along the y-axis each step, in fixed point
+ * @param i is the index of the asteroid
+ * @return the velocity, at most ONE_TILE either way
+ */
+int AsteroidField::getYvel(size_t i) const {
+    return yVel[i];
+}
+
+/**
+ * @brief AsteroidField::getLevel gets how many times an asteroid broke up
+ * @param i is the index of the asteroid
+ * @return 0 for a whole asteroid, up to MAX_LEVEL for the smallest fragments
+ */
+int AsteroidField::getLevel(size_t i) const {
+    return level[i];
+}
+
+/**
+ * @brief AsteroidField::move moves every asteroid by its velocity in a single pass. Only the asteroids that
+ * moved onto another tile are moved in the occupancy grid, which is a small part of them when they move a
+ * fraction of a tile each step. Asteroids are not respawned here; the caller respawns the ones marked in the mask, in index
+ * order, so that the spawns stay in a fixed order.
+ * @param bounds is the part of the gameboard the asteroids may occupy and the location of the ship
+ * @param respawn_mask is resized to one bit per asteroid. A bit is set if the asteroid has left the gameboard.
+ * @return true if an asteroid reached the ship, false otherwise
+ */
+bool AsteroidField::move(const Bounds& bounds, std::vector<unsigned char>& respawn_mask) {
+    respawn_mask.assign((x.size() + 7) / 8, 0);
+
+    if(x.empty()) {
+        return false;
+    }
+
+    crossed.assign(respawn_mask.size(), 0);
+
+    bool hit = step_asteroids(fx.data(), fy.data(), x.data(), y.data(), xVel.data(), yVel.data(), x.size(), bounds,
+                              respawn_mask.data(), crossed.data());
+
+    for(size_t byte = 0; byte < crossed.size(); ++byte) {
+        unsigned bits = crossed[byte];
+        while(bits != 0) {
+            int bit = 0;
+            while(!(bits & (1u << bit))) {
+                ++bit;
+            }
+            size_t i = byte * 8 + bit;
+            grid.remove((fx[i] - xVel[i]) >> FRACTION_BITS, (fy[i] - yVel[i]) >> FRACTION_BITS, (int)i);
+            grid.insert(x[i], y[i], (int)i);
+            bits &= bits - 1;
+        }
+    }
+
+    return hit;
+}
+
+/**
+ * @brief AsteroidField::collide makes the asteroids that touch bounce off each other. An asteroid is a square as
+ * wide as a tile, halved for each level, around its center, so two asteroids can only touch when their tiles are
+ * next to each other. The broadphase therefore only visits the three by three tiles around each asteroid, reading
+ * each row of three from the bitboard at once away from the edges, and costs the same per asteroid however many
+ * there are, plus the pairs that actually touch.
+ *
+ * The pairs bounce in order of the lower index and then the higher one, so the outcome does not depend on the order
+ * of the occupancy grid. Only the partners of one asteroid are kept and sorted at a time; since bouncing changes
+ * velocities but not positions, which pairs touch does not depend on the bounces before them.
+ *
+ * Two asteroids that touch and approach each other swap their velocities, as two equal masses would when they
+ * meet head on. Asteroids that already move apart are left alone, so a pair that still touches after bouncing
+ * does not bounce back. Every velocity stays one a spawned asteroid could have, so no asteroid skips a tile.
+ * @return the number of pairs that bounced
+ */
+size_t AsteroidField::collide() {
+    size_t bounces = 0;
+
+    for(size_t i = 0; i < x.size(); ++i) {
+        contacts.clear();
+        bool window = x[i] > 0 && x[i] < rows - 1 && y[i] > 0 && y[i] < cols - 1;
+
+        for(int nx = x[i] - 1; nx <= x[i] + 1; ++nx) {
+            unsigned row = 0x7;
+            if(window) {
+                row = grid.occupied_run((size_t)nx * cols + y[i] - 1, 3);
+            }
+
+            for(int ny = y[i] - 1; row != 0; ++ny, row >>= 1) {
+                if(!(row & 1)) {
+                    continue;
+                }
+                for(int j = grid.list_at(nx, ny); j != -1; j = grid.next_in_list(j)) {
+                    if((size_t)j > i && touching(i, j)) {
+                        contacts.push_back(j);
+                    }
+                }
+            }
+        }
+
+        std::sort(contacts.begin(), contacts.end());
+
+        for(int j : contacts) {
+            long long dx = fx[j] - fx[i];
+            long long dy = fy[j] - fy[i];
+            long long approach = (xVel[j] - xVel[i]) * dx + (yVel[j] - yVel[i]) * dy;
+            if(approach < 0) {
+                std::swap(xVel[i], xVel[j]);
+                std::swap(yVel[i], yVel[j]);
+                ++bounces;
+            }
+        }
+    }
+
+    return bounces;
+}
+
+/**
+ * @brief AsteroidField::touching checks if two asteroids overlap
+ * @return true if their squares overlap, false otherwise
+ */
+bool AsteroidField::touching(size_t i, size_t j) const {
+    int reach = ((ONE_TILE >> level[i]) + (ONE_TILE >> level[j])) / 2;
+    return std::abs(fx[j] - fx[i]) < reach && std::abs(fy[j] - fy[i]) < reach;
+}
+
+/**
+ * @brief AsteroidField::first_at finds the asteroid on a tile
+ * @param x is the row of the tile
+ * @param y is the column of the tile
+ * @return the lowest index of the asteroids on the tile, or -1 if there is none
+ */
+int AsteroidField::first_at(int x, int y) const {
+    return grid.first_at(x, y);
+}
+
+/**
+ * @brief AsteroidField::occupancy gets the occupancy grid of the asteroids
+ * @return a reference to the occupancy grid
+ */
+const OccupancyGrid& AsteroidField::occupancy() const {
+    return grid;
+}
+
+/**
+ * @brief AsteroidField::state_size gets the number of bytes save_state() writes
+ * @return four ints and a byte per asteroid
+ */
+size_t AsteroidField::state_size() const {
+    return (4 * sizeof(int) + 1) * x.size();
+}
+
+/**
+ * @brief AsteroidField::save_state copies the fixed point positions, the velocities and the levels of every asteroid,
+ * one array after the other. The tiles and the occupancy grid follow from the positions and are not saved.
+ * @param out receives state_size() bytes
+ */
+void AsteroidField::save_state(unsigned char* out) const {
+    size_t bytes = sizeof(int) * x.size();
+    std::memcpy(out, fx.data(), bytes);
+    std::memcpy(out + bytes, fy.data(), bytes);
+    std::memcpy(out + 2 * bytes, xVel.data(), bytes);
+    std::memcpy(out + 3 * bytes, yVel.data(), bytes);
+    std::memcpy(out + 4 * bytes, level.data(), x.size());
+}
+
+/**
+ * @brief AsteroidField::restore_state replaces the asteroids with the ones saved by save_state(). The tile of each
+ * asteroid is taken from its position and the occupancy grid is indexed again. Nothing is allocated unless the
+ * field never held n asteroids before.
+ * @param in holds the bytes written by save_state(), which passed valid_state()
+ * @param n is the number of asteroids that were saved
+ */
+void AsteroidField::restore_state(const unsigned char* in, size_t n) {
+    size_t bytes = sizeof(int) * n;
+
+    fx.resize(n);
+    fy.resize(n);
+    x.resize(n);
+    y.resize(n);
+    xVel.resize(n);
+    yVel.resize(n);
+    level.resize(n);
+
+    std::memcpy(fx.data(), in, bytes);
+    std::memcpy(fy.data(), in + bytes, bytes);
+    std::memcpy(xVel.data(), in + 2 * bytes, bytes);
+    std::memcpy(yVel.data(), in + 3 * bytes, bytes);
+    std::memcpy(level.data(), in + 4 * bytes, n);
+
+    for(size_t i = 0; i < n; ++i) {
+        x[i] = fx[i] >> FRACTION_BITS;
+        y[i] = fy[i] >> FRACTION_BITS;
+    }
+
+    grid.rebuild(x.data(), y.data(), n);
+}
+
+/**
+ * @brief AsteroidField::valid_state checks asteroids saved by save_state() before they are restored. Every asteroid
+ * must be on the gameboard, or at most margin tiles past its edge, move at most a tile per step and be at most
+ * MAX_LEVEL, as the asteroids of a game always are; the search for hits and collide() rely on it.
+ * @param in holds the bytes written by save_state()
+ * @param n is the number of asteroids that were saved
+ * @param rows is the number of rows of the gameboard
+ * @param cols is the number of columns of the gameboard
+ * @param margin is the number of tiles an asteroid may be past the edge of the gameboard
+ * @return true if the asteroids can be restored, false otherwise
+ */
+bool AsteroidField::valid_state(const unsigned char* in, size_t n, int rows, int cols, int margin) {
+    size_t bytes = sizeof(int) * n;
+
+    for(size_t i = 0; i < n; ++i) {
+        int v[4];
+        for(int k = 0; k < 4; ++k) {
+            std::memcpy(&v[k], in + k * bytes + i * sizeof(int), sizeof(int));
+        }
+        int tile_x = v[0] >> FRACTION_BITS;
+        int tile_y = v[1] >> FRACTION_BITS;
+
+        if(tile_x < -margin || tile_x >= rows + margin || tile_y < -margin || tile_y >= cols + margin
+                || v[2] < -ONE_TILE || v[2] > ONE_TILE || v[3] < -ONE_TILE || v[3] > ONE_TILE
+                || in[4 * bytes + i] > MAX_LEVEL) {
+            return false;
+        }
+    }
+    return true;
+}
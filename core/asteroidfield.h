@@ -0,0 +1,102 @@
+/** @file asteroidfield.h
+ *  @brief Class declaration for the AsteroidField class. Stores every asteroid of a game as a structure of arrays.
+ */
+
+#ifndef ASTEROIDFIELD_H
+#define ASTEROIDFIELD_H
+
+#include "occupancygrid.h"
+#include "rng.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The AsteroidField class holds the position and velocity of every asteroid in packed arrays,
+ * so that moving them can be done by a vectorized kernel. An asteroid is identified by its index in the field.
+ *
+ * Positions and velocities are fixed point integers with ONE_TILE units to a tile, so an asteroid moves a fraction
+ * of a tile each step and the arithmetic stays exact and vectorizable. The position is the center of the asteroid;
+ * the tile it is on, which the rest of the game uses, is kept next to it. Every asteroid gets its own speed when it
+ * spawns, around the speed set with set_speed().
+ *
+ * The field also keeps an OccupancyGrid of the gameboard up to date, so the asteroids on a tile are found in one lookup.
+ *
+ * An asteroid can break into fragments, which are asteroids of a higher level and half the size for each level, up
+ * to MAX_LEVEL. Asteroids bounce off each other in collide(), which uses the OccupancyGrid as its broadphase.
+ */
+class AsteroidField {
+public:
+    /**
+     * @brief The Bounds struct describes the part of the gameboard an asteroid may occupy
+     * and the location of the ship.
+     */
+    struct Bounds {
+        int max_x;
+        int max_y;
+        int ship_x;
+        int ship_y;
+    };
+
+    static const int FRACTION_BITS = 16;
+    static const int ONE_TILE = 1 << FRACTION_BITS;
+    static const int MAX_LEVEL = 2;
+    static const int MAX_FRAGMENTS = 8;
+
+    AsteroidField();
+
+    void set_board(int rows, int cols);
+    void set_speed(int tile_time, int step, int spread);
+
+    size_t size() const;
+    void clear();
+    void reserve(size_t n);
+
+    size_t spawn(Rng& rng);
+    size_t spawn_wave(size_t n, Rng& rng);
+    void respawn(size_t i, Rng& rng);
+    size_t spawn_fragments(size_t i, int count, Rng& rng);
+    void remove(size_t i);
+
+    int getX(size_t i) const;
+    int getY(size_t i) const;
+    int getFixedX(size_t i) const;
+    int getFixedY(size_t i) const;
+    int getXvel(size_t i) const;
+    int getYvel(size_t i) const;
+    int getLevel(size_t i) const;
+
+    bool move(const Bounds& bounds, std::vector<unsigned char>& respawn_mask);
+    size_t collide();
+
+    int first_at(int x, int y) const;
+    const OccupancyGrid& occupancy() const;
+
+    size_t state_size() const;
+    void save_state(unsigned char* out) const;
+    void restore_state(const unsigned char* in, size_t n);
+    static bool valid_state(const unsigned char* in, size_t n, int rows, int cols, int margin);
+
+private:
+    void place(size_t i, Rng& rng);
+    bool touching(size_t i, size_t j) const;
+
+    std::vector<int> fx;
+    std::vector<int> fy;
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> xVel;
+    std::vector<int> yVel;
+    std::vector<unsigned char> level;
+
+    std::vector<unsigned char> crossed;
+    std::vector<int> contacts;
+
+    int rows;
+    int cols;
+    int speed;
+    int speedSpread;
+    OccupancyGrid grid;
+};
+
+#endif // ASTEROIDFIELD_H
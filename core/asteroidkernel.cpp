@@ -0,0 +1,214 @@
+/** @file asteroidkernel.cpp
+ *  @brief This file contains the definition of the asteroid kernels. The AVX2 kernel is compiled with a target
+ *         attribute and chosen at runtime, so the library still runs on processors without AVX2. Both kernels are
+ *         templated on the size of the gameboard and instantiated for every FixedBoard.
+ */
+
+#include "asteroidkernel.h"
+#include "boardgeometry.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ASTEROIDS_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief step_range moves the asteroids in [begin, end) one at a time.
+ * @return true if one of them reached the ship, false otherwise
+ */
+static bool step_range(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t begin, size_t end,
+                       const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    bool hit = false;
+
+    for(size_t i = begin; i < end; ++i) {
+        fx[i] += xVel[i];
+        fy[i] += yVel[i];
+
+        // an arithmetic shift rounds down, also for the asteroids that left the top or the left of the gameboard
+        int nx = fx[i] >> AsteroidField::FRACTION_BITS;
+        int ny = fy[i] >> AsteroidField::FRACTION_BITS;
+        crossed[i >> 3] |= (unsigned char)(nx != x[i] || ny != y[i]) << (i & 7);
+        x[i] = nx;
+        y[i] = ny;
+
+        hit |= nx == bounds.ship_x && ny == bounds.ship_y;
+
+        // we need the topleft corner of our asteroid image to be on the grid, or on the last row or column
+        // while the asteroid is still entering from the bottom or the right
+        bool valid = nx > -1 && nx < bounds.max_x + (xVel[i] < 0) && ny > -1 && ny < bounds.max_y + (yVel[i] < 0);
+        respawn[i >> 3] |= (unsigned char)(!valid) << (i & 7);
+    }
+
+    return hit;
+}
+
+/**
+ * @brief step_board moves the asteroids eight at a time, which fills one byte of each mask, and does the rest one
+ * at a time. The eight asteroids of a byte are an inner loop of fixed length that the compiler unrolls, and each
+ * byte of the masks is built in a register and stored once.
+ * @return true if one of them reached the ship, false otherwise
+ */
+template<class Board>
+static bool step_board(const Board& board, int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                       const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    bool hit = false;
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8) {
+        unsigned left = 0;
+        unsigned moved = 0;
+
+        for(int k = 0; k < 8; ++k) {
+            size_t j = i + k;
+            fx[j] += xVel[j];
+            fy[j] += yVel[j];
+
+            int nx = fx[j] >> AsteroidField::FRACTION_BITS;
+            int ny = fy[j] >> AsteroidField::FRACTION_BITS;
+            moved |= (unsigned)(nx != x[j] || ny != y[j]) << k;
+            x[j] = nx;
+            y[j] = ny;
+
+            hit |= nx == bounds.ship_x && ny == bounds.ship_y;
+            left |= (unsigned)!board.inside(nx, ny, xVel[j], yVel[j]) << k;
+        }
+
+        respawn[i >> 3] = (unsigned char)left;
+        crossed[i >> 3] = (unsigned char)moved;
+    }
+
+    return step_range(fx, fy, x, y, xVel, yVel, i, n, bounds, respawn, crossed) || hit;
+}
+
+/**
+ * @brief step_asteroids_scalar moves the asteroids without vector instructions.
+ */
+bool step_asteroids_scalar(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                           const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    return step_board(RuntimeBoard(bounds.max_x + 1, bounds.max_y + 1), fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+}
+
+#ifdef ASTEROIDS_HAVE_AVX2
+
+/**
+ * @brief avx2_supported checks if the processor can run the AVX2 kernel
+ * @return true if AVX2 is available, false otherwise
+ */
+bool avx2_supported() {
+    return __builtin_cpu_supports("avx2");
+}
+
+/**
+ * @brief step_board_avx2 moves eight asteroids per iteration. The eight bits of an iteration
+ * fill exactly one byte of each mask. The last row and column are kept for the asteroids moving away from them
+ * by adding the sign bit of the velocity to the bound.
+ */
+template<class Board>
+__attribute__((target("avx2")))
+static bool step_board_avx2(const Board& board, int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                            const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    const __m256i lowest = _mm256_set1_epi32(-1);
+    const __m256i max_x = _mm256_set1_epi32(board.rows() - 1);
+    const __m256i max_y = _mm256_set1_epi32(board.cols() - 1);
+    const __m256i ship_x = _mm256_set1_epi32(bounds.ship_x);
+    const __m256i ship_y = _mm256_set1_epi32(bounds.ship_y);
+
+    __m256i hit = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8) {
+        __m256i vx = _mm256_loadu_si256((const __m256i*)(xVel + i));
+        __m256i vy = _mm256_loadu_si256((const __m256i*)(yVel + i));
+        __m256i px = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(fx + i)), vx);
+        __m256i py = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(fy + i)), vy);
+        _mm256_storeu_si256((__m256i*)(fx + i), px);
+        _mm256_storeu_si256((__m256i*)(fy + i), py);
+
+        __m256i nx = _mm256_srai_epi32(px, AsteroidField::FRACTION_BITS);
+        __m256i ny = _mm256_srai_epi32(py, AsteroidField::FRACTION_BITS);
+        __m256i same = _mm256_and_si256(_mm256_cmpeq_epi32(nx, _mm256_loadu_si256((const __m256i*)(x + i))),
+                                        _mm256_cmpeq_epi32(ny, _mm256_loadu_si256((const __m256i*)(y + i))));
+        crossed[i >> 3] = (unsigned char)(~_mm256_movemask_ps(_mm256_castsi256_ps(same)) & 0xff);
+        _mm256_storeu_si256((__m256i*)(x + i), nx);
+        _mm256_storeu_si256((__m256i*)(y + i), ny);
+
+        hit = _mm256_or_si256(hit, _mm256_and_si256(_mm256_cmpeq_epi32(nx, ship_x), _mm256_cmpeq_epi32(ny, ship_y)));
+
+        __m256i valid = _mm256_and_si256(
+                    _mm256_and_si256(_mm256_cmpgt_epi32(nx, lowest),
+                                     _mm256_cmpgt_epi32(_mm256_sub_epi32(max_x, _mm256_srai_epi32(vx, 31)), nx)),
+                    _mm256_and_si256(_mm256_cmpgt_epi32(ny, lowest),
+                                     _mm256_cmpgt_epi32(_mm256_sub_epi32(max_y, _mm256_srai_epi32(vy, 31)), ny)));
+        respawn[i >> 3] = (unsigned char)(~_mm256_movemask_ps(_mm256_castsi256_ps(valid)) & 0xff);
+    }
+
+    bool tail_hit = step_range(fx, fy, x, y, xVel, yVel, i, n, bounds, respawn, crossed);
+    return tail_hit || !_mm256_testz_si256(hit, hit);
+}
+
+/**
+ * @brief step_asteroids_avx2 moves the asteroids with AVX2, reading the size of the gameboard at runtime.
+ */
+bool step_asteroids_avx2(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                         const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    return step_board_avx2(RuntimeBoard(bounds.max_x + 1, bounds.max_y + 1), fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+}
+
+#else
+
+/**
+ * @brief avx2_supported checks if the processor can run the AVX2 kernel
+ * @return false, the AVX2 kernel is not built for this compiler or processor
+ */
+bool avx2_supported() {
+    return false;
+}
+
+/**
+ * @brief step_board_avx2 falls back to the scalar kernel where AVX2 is not built.
+ */
+template<class Board>
+static bool step_board_avx2(const Board& board, int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                            const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    return step_board(board, fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+}
+
+/**
+ * @brief step_asteroids_avx2 falls back to the scalar kernel where AVX2 is not built.
+ */
+bool step_asteroids_avx2(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                         const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    return step_asteroids_scalar(fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+}
+
+#endif
+
+/**
+ * @brief step_asteroids moves the asteroids with the fastest kernel the processor supports, specialized for the
+ * size of the gameboard when it is one of the FixedBoard layouts.
+ */
+bool step_asteroids(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                    const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    static const bool use_avx2 = avx2_supported();
+
+    return with_board(bounds.max_x + 1, bounds.max_y + 1, [&](const auto& board) {
+        if(use_avx2) {
+            return step_board_avx2(board, fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+        }
+        return step_board(board, fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+    });
+}
+
+/**
+ * @brief step_asteroids_generic moves the asteroids with the fastest kernel the processor supports, reading the
+ * size of the gameboard at runtime whatever it is.
+ */
+bool step_asteroids_generic(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                            const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed) {
+    static const bool use_avx2 = avx2_supported();
+
+    if(use_avx2) {
+        return step_asteroids_avx2(fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+    }
+    return step_asteroids_scalar(fx, fy, x, y, xVel, yVel, n, bounds, respawn, crossed);
+}
@@ -0,0 +1,37 @@
+/** @file asteroidkernel.h
+ *  @brief Declares the kernels which move the asteroids of an AsteroidField.
+ */
+
+#ifndef ASTEROIDKERNEL_H
+#define ASTEROIDKERNEL_H
+
+#include "asteroidfield.h"
+
+#include <cstddef>
+
+/**
+ * All of the kernels add the fixed point velocity (xVel, yVel) of n asteroids to their fixed point position
+ * (fx, fy), store the tile each asteroid is now on in (x, y), then test the tiles against the bounds and the
+ * ship in the same pass. Only integer adds, shifts and compares are used. Bit i of respawn (asteroid i) is set
+ * when the asteroid has left the bounds, and bit i of crossed when it moved onto another tile; both must hold
+ * (n + 7) / 8 zeroed bytes. An asteroid on the last row or column is within the bounds while it moves away from
+ * it, as the asteroids entering from the bottom and the right do. They return true if any asteroid reached the ship.
+ *
+ * step_asteroids() is specialized for the size of the gameboard when it is one of the FixedBoard layouts and
+ * falls back to step_asteroids_generic() otherwise. The other kernels read the size of the gameboard at runtime.
+ */
+bool step_asteroids(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                    const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed);
+
+bool step_asteroids_generic(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                            const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed);
+
+bool step_asteroids_scalar(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                           const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed);
+
+bool step_asteroids_avx2(int* fx, int* fy, int* x, int* y, const int* xVel, const int* yVel, size_t n,
+                         const AsteroidField::Bounds& bounds, unsigned char* respawn, unsigned char* crossed);
+
+bool avx2_supported();
+
+#endif // ASTEROIDKERNEL_H
@@ -0,0 +1,130 @@
+/** @file batchrunner.cpp
+ *  @brief This file contains the definition of the BatchRunner class.
+ */
+
+#include "batchrunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+/**
+ * @brief The GameResult struct holds the outcome of one game of a batch.
+ */
+struct GameResult {
+    long long survival;
+    size_t asteroids_hit;
+    size_t shots_fired;
+};
+
+/**
+ * @brief BatchRunner::BatchRunner starts the workers of the batch runner.
+ * @param threads is the number of games played at once, or 0 for one per core
+ * @param tick_length is the number of milliseconds of game time in one tick
+ */
+BatchRunner::BatchRunner(unsigned threads, int tick_length) : pool(threads), tickLength(tick_length), timeLimit(DEFAULT_TIME_LIMIT) {
+}
+
+/**
+ * @brief BatchRunner::set_time_limit changes the game time after which a game is stopped even if it is not over,
+ * so that a bot which never loses cannot hold up a batch.
+ * @param time_limit is the game time in milliseconds
+ */
+void BatchRunner::set_time_limit(long long time_limit) {
+    timeLimit = time_limit;
+}
+
+/**
+ * @brief BatchRunner::run plays a batch of games and gathers their results. Survival is the game time until an
+ * asteroid reached the ship, in milliseconds.
+ * @param settings are the settings of every game. Game n is seeded with settings.seed + n.
+ * @param games is the number of games to play
+ * @param bot creates the bot of each worker
+ * @return the report of the batch
+ */
+BatchRunner::Report BatchRunner::run(const World::Settings& settings, size_t games, const BotFactory& bot) {
+    std::vector<std::unique_ptr<World> > worlds;
+    std::vector<std::unique_ptr<Bot> > bots;
+    for(unsigned w = 0; w < pool.size(); ++w) {
+        worlds.push_back(std::unique_ptr<World>(new World(settings)));
+        bots.push_back(bot());
+    }
+
+    std::vector<GameResult> results(games);
+    auto start = std::chrono::steady_clock::now();
+
+    pool.run(games, [&](size_t game, unsigned worker) {
+        World& world = *worlds[worker];
+        Bot& player = *bots[worker];
+
+        World::Settings config = settings;
+        config.seed = settings.seed + game;
+        world.set_settings(config);
+        world.reset();
+        player.reset(game);
+
+        World::Input input;
+        while(!world.is_over() && world.elapsed() < timeLimit) {
+            if(player.press(world, input)) {
+                world.apply(input);
+            }
+            world.step(tickLength);
+        }
+
+        GameResult& result = results[game];
+        result.survival = world.elapsed();
+        result.asteroids_hit = world.num_asteroids_hit();
+        result.shots_fired = world.num_shots_fired();
+    });
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Report report;
+    report.games = games;
+    report.threads = pool.size();
+    report.seconds = seconds;
+    report.games_per_second = seconds > 0 ? games / seconds : 0;
+
+    std::vector<long long> survival(games);
+    long long total_survival = 0;
+    report.games_at_time_limit = 0;
+    report.asteroids_hit = 0;
+    report.shots_fired = 0;
+    for(size_t i = 0; i < games; ++i) {
+        survival[i] = results[i].survival;
+        total_survival += results[i].survival;
+        report.games_at_time_limit += results[i].survival >= timeLimit;
+        report.asteroids_hit += results[i].asteroids_hit;
+        report.shots_fired += results[i].shots_fired;
+    }
+    std::sort(survival.begin(), survival.end());
+
+    report.mean_survival = games != 0 ? (double)total_survival / games : 0;
+    report.median_survival = games != 0 ? survival[games / 2] : 0;
+    report.max_survival = games != 0 ? survival.back() : 0;
+    report.mean_asteroids_hit = games != 0 ? (double)report.asteroids_hit / games : 0;
+    report.accuracy = report.shots_fired != 0 ? report.asteroids_hit * 100.0 / report.shots_fired : 0;
+
+    return report;
+}
+
+/**
+ * @brief BatchRunner::Report::summary writes the report in the words of the gameover screen.
+ * Survival times are in seconds.
+ * @return the summary
+ */
+std::string BatchRunner::Report::summary() const {
+    std::ostringstream out;
+    out << "Games: " << games << " on " << threads << " threads in " << seconds << " s"
+        << "  (" << games_per_second << " games/sec)\n";
+    out << "Survival: mean " << mean_survival / 1000 << " s  median " << median_survival / 1000.0
+        << " s  max " << max_survival / 1000.0 << " s  (" << games_at_time_limit << " games reached the time limit)\n";
+    out << "Number of Asteroids Destroyed: " << asteroids_hit << "  (" << mean_asteroids_hit << " per game)\n";
+    if(shots_fired != 0) {
+        out << "Accuracy: " << accuracy << "%  (" << shots_fired << " shots fired)";
+    } else {
+        out << "Accuracy: No shots were fired!";
+    }
+    return out.str();
+}
@@ -0,0 +1,65 @@
+/** @file batchrunner.h
+ *  @brief Class declaration for the BatchRunner class. Plays many headless games with a bot to measure a difficulty setting.
+ */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "world.h"
+#include "bot.h"
+#include "workstealingpool.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * @brief The BatchRunner class plays a batch of games with the same settings in parallel on a WorkStealingPool.
+ * Game n is seeded with Settings::seed + n and its bot with the same number, so a batch always plays out the
+ * same way however the games are spread over the workers. Each worker reuses one World and one Bot for all of
+ * its games. The inputs of the bot are applied between ticks, like the inputs of a player.
+ */
+class BatchRunner {
+public:
+    /**
+     * @brief BotFactory creates the bot of a worker.
+     */
+    typedef std::function<std::unique_ptr<Bot>()> BotFactory;
+
+    /**
+     * @brief The Report struct holds the results of a batch.
+     */
+    struct Report {
+        size_t games;
+        unsigned threads;
+        double seconds;
+        double games_per_second;
+
+        double mean_survival;
+        long long median_survival;
+        long long max_survival;
+        size_t games_at_time_limit;
+
+        size_t asteroids_hit;
+        size_t shots_fired;
+        double mean_asteroids_hit;
+        double accuracy;
+
+        std::string summary() const;
+    };
+
+    static const long long DEFAULT_TIME_LIMIT = 10 * 60 * 1000;
+
+    explicit BatchRunner(unsigned threads = 0, int tick_length = 10);
+
+    void set_time_limit(long long time_limit);
+    Report run(const World::Settings& settings, size_t games, const BotFactory& bot);
+
+private:
+    WorkStealingPool pool;
+    int tickLength;
+    long long timeLimit;
+};
+
+#endif // BATCHRUNNER_H
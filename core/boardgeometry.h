@@ -0,0 +1,125 @@
+/** @file boardgeometry.h
+ *  @brief Declares the FixedBoard and RuntimeBoard classes, which describe the size of a gameboard to the kernels
+ *         that are templated on it, and with_board(), which picks the fixed size a gameboard matches.
+ */
+
+#ifndef BOARDGEOMETRY_H
+#define BOARDGEOMETRY_H
+
+#include <cstddef>
+
+/**
+ * @brief log2_of gets the base two logarithm of a power of two
+ */
+constexpr int log2_of(int value) {
+    return value <= 1 ? 0 : 1 + log2_of(value / 2);
+}
+
+/**
+ * @brief The FixedBoard class is a gameboard whose size is known when the program is compiled. The tests and the
+ * tile indices compile to immediates; on a square gameboard whose side is a power of two, a tile is on the gameboard
+ * when no bit above the side is set in either coordinate, and the index of a tile is a shift and an or.
+ *
+ * Tiles are indexed row by row, as in the OccupancyGrid. An asteroid stays inside() while its tile is on the
+ * gameboard without the last row and the last column, so the image of the asteroid fits on the gameboard. The
+ * asteroids that enter from the bottom or the right start on the last row or column, so an asteroid there stays
+ * inside() for as long as it moves away from it.
+ */
+template<int ROWS, int COLS>
+class FixedBoard {
+public:
+    static const bool POWER_OF_TWO = ROWS == COLS && (ROWS & (ROWS - 1)) == 0;
+    static const bool POWER_OF_TWO_COLS = (COLS & (COLS - 1)) == 0;
+
+    int rows() const {
+        return ROWS;
+    }
+
+    int cols() const {
+        return COLS;
+    }
+
+    bool on_board(int x, int y) const {
+        if(POWER_OF_TWO) {
+            return ((unsigned)x | (unsigned)y) < (unsigned)ROWS;
+        }
+        return (unsigned)x < (unsigned)ROWS && (unsigned)y < (unsigned)COLS;
+    }
+
+    bool inside(int x, int y, int xVel, int yVel) const {
+        return (unsigned)x < (unsigned)(ROWS - 1 + (xVel < 0)) && (unsigned)y < (unsigned)(COLS - 1 + (yVel < 0));
+    }
+
+    size_t cell(int x, int y) const {
+        if(POWER_OF_TWO_COLS) {
+            return ((size_t)x << log2_of(COLS)) | (size_t)y;
+        }
+        return (size_t)x * COLS + y;
+    }
+};
+
+/**
+ * @brief The RuntimeBoard class is a gameboard of any size, read from memory by every test. It is the fallback
+ * for the sizes that have no FixedBoard.
+ */
+class RuntimeBoard {
+public:
+    RuntimeBoard(int rows, int cols) : numRows(rows), numCols(cols) {
+    }
+
+    int rows() const {
+        return numRows;
+    }
+
+    int cols() const {
+        return numCols;
+    }
+
+    bool on_board(int x, int y) const {
+        return (unsigned)x < (unsigned)numRows && (unsigned)y < (unsigned)numCols;
+    }
+
+    bool inside(int x, int y, int xVel, int yVel) const {
+        return (unsigned)x < (unsigned)(numRows - 1 + (xVel < 0)) && (unsigned)y < (unsigned)(numCols - 1 + (yVel < 0));
+    }
+
+    size_t cell(int x, int y) const {
+        return (size_t)x * numCols + y;
+    }
+
+private:
+    int numRows;
+    int numCols;
+};
+
+/**
+ * @brief with_board calls a function with the FixedBoard of a gameboard, or with a RuntimeBoard if the size is not
+ * one of the production layouts: the 23 by 23 gameboard of the game and the square gameboards of 64, 256, 1024 and
+ * 4096 tiles that --grid-size is used with.
+ * @param rows is the number of rows of the gameboard
+ * @param cols is the number of columns of the gameboard
+ * @param fn is called with the board, for example a generic lambda
+ * @return what fn returned
+ */
+template<class Fn>
+auto with_board(int rows, int cols, Fn&& fn) -> decltype(fn(RuntimeBoard(rows, cols))) {
+    if(rows == cols) {
+        switch(rows) {
+        case(23):
+            return fn(FixedBoard<23, 23>());
+        case(64):
+            return fn(FixedBoard<64, 64>());
+        case(256):
+            return fn(FixedBoard<256, 256>());
+        case(1024):
+            return fn(FixedBoard<1024, 1024>());
+        case(4096):
+            return fn(FixedBoard<4096, 4096>());
+        default:
+            break;
+        }
+    }
+    return fn(RuntimeBoard(rows, cols));
+}
+
+#endif // BOARDGEOMETRY_H
@@ -0,0 +1,113 @@
+/** @file bot.cpp
+ *  @brief This file contains the definitions of the Bot classes.
+ */
+
+#include "bot.h"
+
+#include <cmath>
+#include <cstdlib>
+
+/**
+ * @brief Bot::Bot is the constructor for the Bot class.
+ */
+Bot::Bot() : nextPress(0) {
+}
+
+/**
+ * @brief Bot::~Bot is the destructor for the Bot class.
+ */
+Bot::~Bot() {
+}
+
+/**
+ * @brief Bot::reset prepares the bot for a new game.
+ * @param seed is the seed of the game, for bots that make random choices
+ */
+void Bot::reset(uint64_t seed) {
+    (void)seed;
+    nextPress = 0;
+}
+
+/**
+ * @brief Bot::press asks the bot for its key press in the current tick. No key is pressed before the
+ * reaction time since the last press has passed.
+ * @param world is the world being played
+ * @param input is set to the key to press
+ * @return true if a key is pressed, false otherwise
+ */
+bool Bot::press(const World& world, World::Input& input) {
+    if(world.elapsed() < nextPress || !choose(world, input)) {
+        return false;
+    }
+
+    nextPress = world.elapsed() + REACTION_TIME;
+    return true;
+}
+
+/**
+ * @brief RandomBot::reset seeds the bot with the seed of the game, so a batch of games is reproducible.
+ * @param seed is the seed of the game
+ */
+void RandomBot::reset(uint64_t seed) {
+    Bot::reset(seed);
+    rng.seed(seed);
+}
+
+/**
+ * @brief RandomBot::choose picks one of the three keys at random.
+ * @param world is the world being played
+ * @param input is set to the key to press
+ * @return true
+ */
+bool RandomBot::choose(const World& world, World::Input& input) {
+    (void)world;
+    input = (World::Input)rng.uniform(World::ROTATE_LEFT, World::FIRE);
+    return true;
+}
+
+/**
+ * @brief AimBot::choose finds the nearest asteroid and the one of the eight directions of the ship closest to it.
+ * The ship turns toward that direction, and fires when it faces it and another shot can be fired.
+ * @param world is the world being played
+ * @param input is set to the key to press
+ * @return true if a key is pressed, false if there is nothing to do
+ */
+bool AimBot::choose(const World& world, World::Input& input) {
+    const World::Settings& settings = world.settings();
+    const AsteroidField& field = world.asteroids();
+
+    long long nearest = -1;
+    int dx = 0;
+    int dy = 0;
+    for(size_t i = 0; i < field.size(); ++i) {
+        int x = field.getX(i) - settings.ship_x;
+        int y = field.getY(i) - settings.ship_y;
+        long long distance = (long long)x * x + (long long)y * y;
+        if(nearest == -1 || distance < nearest) {
+            nearest = distance;
+            dx = x;
+            dy = y;
+        }
+    }
+
+    if(nearest <= 0) {
+        return false;
+    }
+
+    // rows grow to the south and columns to the east; rotations are clockwise from north
+    double degrees = std::atan2((double)dy, (double)-dx) * 180.0 / 3.14159265358979323846;
+    int target = ((int)std::lround(degrees / 45.0) * 45 + 360) % 360;
+    int turn = (target - (int)world.ship_rotation() + 360) % 360;
+
+    if(turn == 0) {
+        if(world.projectiles().full()) {
+            return false;
+        }
+        input = World::FIRE;
+    } else if(turn <= 180) {
+        input = World::ROTATE_RIGHT;
+    } else {
+        input = World::ROTATE_LEFT;
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+/** @file bot.h
+ *  @brief Class declarations for the Bot classes. A Bot plays a World in place of a player.
+ */
+
+#ifndef BOT_H
+#define BOT_H
+
+#include "world.h"
+#include "rng.h"
+
+#include <cstdint>
+
+/**
+ * @brief The Bot class is the interface of a computer player. It can only do what a player can do from the
+ * keyboard: press one of the keys that keyPressEvent handles, which turn the ship or fire. A bot is asked once
+ * per tick and presses a key at most once every REACTION_TIME milliseconds of game time.
+ */
+class Bot {
+public:
+    static const int REACTION_TIME = 100;
+
+    Bot();
+    virtual ~Bot();
+
+    virtual void reset(uint64_t seed);
+    bool press(const World& world, World::Input& input);
+
+protected:
+    /**
+     * @brief choose decides which key to press now
+     * @param world is the world being played
+     * @param input is set to the key to press
+     * @return true if a key is pressed, false to wait
+     */
+    virtual bool choose(const World& world, World::Input& input) = 0;
+
+private:
+    long long nextPress;
+};
+
+/**
+ * @brief The RandomBot class presses a random key whenever it can.
+ */
+class RandomBot : public Bot {
+public:
+    void reset(uint64_t seed);
+
+protected:
+    bool choose(const World& world, World::Input& input);
+
+private:
+    Rng rng;
+};
+
+/**
+ * @brief The AimBot class turns the ship toward the nearest asteroid, the short way round, and fires once the
+ * ship faces it.
+ */
+class AimBot : public Bot {
+protected:
+    bool choose(const World& world, World::Input& input);
+};
+
+#endif // BOT_H
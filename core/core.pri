@@ -0,0 +1,44 @@
+# Sources of the Qt-free simulation core. Included by core.pro to build the
+# static library and by the application projects that compile the core in.
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+HEADERS += $$PWD/alloccounter.h \
+    $$PWD/asteroidfield.h \
+    $$PWD/asteroidkernel.h \
+    $$PWD/batchrunner.h \
+    $$PWD/boardgeometry.h \
+    $$PWD/bot.h \
+    $$PWD/gameloop.h \
+    $$PWD/memoryusage.h \
+    $$PWD/occupancygrid.h \
+    $$PWD/profiler.h \
+    $$PWD/projectilepool.h \
+    $$PWD/recording.h \
+    $$PWD/rng.h \
+    $$PWD/scorelog.h \
+    $$PWD/simulation.h \
+    $$PWD/snapshot.h \
+    $$PWD/snapshotbuffer.h \
+    $$PWD/workstealingpool.h \
+    $$PWD/world.h
+
+SOURCES += $$PWD/alloccounter.cpp \
+    $$PWD/asteroidfield.cpp \
+    $$PWD/asteroidkernel.cpp \
+    $$PWD/batchrunner.cpp \
+    $$PWD/bot.cpp \
+    $$PWD/gameloop.cpp \
+    $$PWD/memoryusage.cpp \
+    $$PWD/occupancygrid.cpp \
+    $$PWD/profiler.cpp \
+    $$PWD/projectilepool.cpp \
+    $$PWD/recording.cpp \
+    $$PWD/rng.cpp \
+    $$PWD/scorelog.cpp \
+    $$PWD/simulation.cpp \
+    $$PWD/snapshot.cpp \
+    $$PWD/snapshotbuffer.cpp \
+    $$PWD/workstealingpool.cpp \
+    $$PWD/world.cpp
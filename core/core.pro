@@ -0,0 +1,14 @@
+#-------------------------------------------------
+#
+# Static library containing the headless simulation core.
+# Has no dependency on Qt.
+#
+#-------------------------------------------------
+
+CONFIG   -= qt
+CONFIG   += staticlib c++14
+
+TARGET = asteroidscore
+TEMPLATE = lib
+
+include(core.pri)
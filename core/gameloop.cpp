@@ -0,0 +1,107 @@
+/** @file gameloop.cpp
+ *  @brief This file contains the definition of the GameLoop class.
+ */
+
+#include "gameloop.h"
+
+/**
+ * @brief GameLoop::GameLoop constructs a loop which drives a world at normal speed.
+ * @param world is the world to step
+ * @param tick_length is the number of milliseconds of game time in one tick
+ */
+GameLoop::GameLoop(World* world, int tick_length) : world(world), tickLength(tick_length), timeScale(1.0) {
+    reset();
+}
+
+/**
+ * @brief GameLoop::reset empties the accumulator. Called when a new game starts.
+ */
+void GameLoop::reset() {
+    accumulator = 0;
+    stepped = 0;
+    tickCount = 0;
+}
+
+/**
+ * @brief GameLoop::advance runs every tick that fits into the elapsed real time. At most MAX_FRAME_TIME
+ * milliseconds of real time are taken from a single frame, so a stall does not make the game race to catch up.
+ * No tick runs once the game is over.
+ * @param real_time is the number of milliseconds of real time since the last call, including fractions
+ * @return the number of ticks that ran
+ */
+int GameLoop::advance(double real_time) {
+    if(real_time > MAX_FRAME_TIME) {
+        real_time = MAX_FRAME_TIME;
+    }
+
+    accumulator += real_time * timeScale;
+
+    int ran = 0;
+    while(accumulator >= tickLength && !world->is_over()) {
+        world->step(tickLength - stepped);
+        stepped = 0;
+        accumulator -= tickLength;
+        ++ran;
+    }
+
+    if(world->is_over()) {
+        accumulator = 0;
+        stepped = 0;
+    }
+
+    tickCount += ran;
+    return ran;
+}
+
+/**
+ * @brief GameLoop::step_within_tick steps the world through the whole milliseconds of the accumulator that have not
+ * been stepped yet, without finishing the tick. The world is then at the game time of the last call to advance(),
+ * to within a millisecond, and an input applied now happens at that time.
+ */
+void GameLoop::step_within_tick() {
+    int to = (int)accumulator;
+    if(to > stepped && !world->is_over()) {
+        world->step(to - stepped);
+        stepped = to;
+    }
+}
+
+/**
+ * @brief GameLoop::set_time_scale changes how fast game time passes compared to real time.
+ * @param scale is the multiplier, 1 for normal speed and 100 to fast-forward a hundred times
+ */
+void GameLoop::set_time_scale(double scale) {
+    timeScale = scale > 0 ? scale : 0;
+}
+
+/**
+ * @brief GameLoop::time_scale gets the multiplier of game time over real time
+ * @return the time scale
+ */
+double GameLoop::time_scale() const {
+    return timeScale;
+}
+
+/**
+ * @brief GameLoop::tick_length gets the length of a tick
+ * @return the number of milliseconds of game time in one tick
+ */
+int GameLoop::tick_length() const {
+    return tickLength;
+}
+
+/**
+ * @brief GameLoop::ticks gets the number of ticks that ran since the last reset
+ * @return the number of ticks
+ */
+long long GameLoop::ticks() const {
+    return tickCount;
+}
+
+/**
+ * @brief GameLoop::alpha gets how far the accumulator is into the next tick, for interpolation
+ * @return a value in [0, 1)
+ */
+double GameLoop::alpha() const {
+    return accumulator / tickLength;
+}
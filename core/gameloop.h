@@ -0,0 +1,45 @@
+/** @file gameloop.h
+ *  @brief Class declaration for the GameLoop class. Drives a World with a fixed timestep.
+ */
+
+#ifndef GAMELOOP_H
+#define GAMELOOP_H
+
+#include "world.h"
+
+/**
+ * @brief The GameLoop class turns elapsed real time into fixed length ticks of a World. Real time is scaled
+ * by the time scale and collected in an accumulator; every whole tick in the accumulator steps the world once,
+ * which advances its subsystems in a fixed order. The world therefore ends up in the same state for the same
+ * inputs, however the real time was split into frames.
+ *
+ * An input that happens between two ticks is applied at the millisecond it happened: step_within_tick() steps the
+ * world through the whole milliseconds in the accumulator first, and the tick that follows only steps the rest.
+ */
+class GameLoop {
+public:
+    static const int MAX_FRAME_TIME = 250;
+
+    explicit GameLoop(World* world, int tick_length = 10);
+
+    void reset();
+    int advance(double real_time);
+    void step_within_tick();
+
+    void set_time_scale(double scale);
+    double time_scale() const;
+
+    int tick_length() const;
+    long long ticks() const;
+    double alpha() const;
+
+private:
+    World* world;
+    int tickLength;
+    double timeScale;
+    double accumulator;
+    int stepped;
+    long long tickCount;
+};
+
+#endif // GAMELOOP_H
@@ -0,0 +1,41 @@
+/** @file memoryusage.cpp
+ *  @brief This file contains the definition of resident_memory() for Linux and macOS.
+ */
+
+#include "memoryusage.h"
+
+#if defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+/**
+ * @brief resident_memory gets the resident set size of the process, which soak runs watch to catch leaks.
+ * @return the number of bytes in physical memory, or 0 where the platform is not supported
+ */
+size_t resident_memory() {
+#if defined(__linux__)
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if(statm == nullptr) {
+        return 0;
+    }
+
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    int read = std::fscanf(statm, "%lu %lu", &size, &resident);
+    std::fclose(statm);
+
+    return read == 2 ? resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,12 @@
+/** @file memoryusage.h
+ *  @brief Declares resident_memory(), which reports how much memory the process is using.
+ */
+
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+
+size_t resident_memory();
+
+#endif // MEMORYUSAGE_H
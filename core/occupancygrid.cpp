@@ -0,0 +1,236 @@
+/** @file occupancygrid.cpp
+ *  @brief This file contains the definition of the OccupancyGrid class.
+ */
+
+#include "occupancygrid.h"
+
+/**
+ * @brief OccupancyGrid::OccupancyGrid constructs an empty grid. Nothing is indexed until resize() is called.
+ */
+OccupancyGrid::OccupancyGrid() : rows(0), cols(0) {
+}
+
+/**
+ * @brief OccupancyGrid::resize changes the size of the gameboard and removes every entity from the grid.
+ * When the size does not change, the storage is kept and only cleared.
+ * @param rows is the number of rows of the gameboard
+ * @param cols is the number of columns of the gameboard
+ */
+void OccupancyGrid::resize(int rows, int cols) {
+    if(rows == this->rows && cols == this->cols) {
+        clear();
+        return;
+    }
+
+    this->rows = rows;
+    this->cols = cols;
+
+    size_t cells = (size_t)rows * cols;
+    bits.assign((cells + 63) / 64, 0);
+    head.assign(cells, -1);
+    next.clear();
+    touched.clear();
+}
+
+/**
+ * @brief OccupancyGrid::clear removes every entity from the grid. Only the tiles that became occupied since the
+ * last clear are visited, so clearing costs the same on a 4096 by 4096 gameboard as on the original one.
+ */
+void OccupancyGrid::clear() {
+    for(size_t c : touched) {
+        head[c] = -1;
+        bits[c >> 6] = 0;
+    }
+    touched.clear();
+}
+
+/**
+ * @brief OccupancyGrid::insert adds an entity to a tile. Nothing happens if the tile is off the gameboard.
+ * @param x is the row of the tile
+ * @param y is the column of the tile
+ * @param i is the index of the entity
+ */
+void OccupancyGrid::insert(int x, int y, int i) {
+    if(!on_board(x, y)) {
+        return;
+    }
+
+    if((size_t)i >= next.size()) {
+        next.resize(i + 1, -1);
+    }
+
+    size_t c = cell(x, y);
+    if(head[c] == -1) {
+        if(touched.size() >= 2 * next.size() + 64) {
+            compact_touched();
+        }
+        touched.push_back(c);
+    }
+
+    next[i] = head[c];
+    head[c] = i;
+    bits[c >> 6] |= (uint64_t)1 << (c & 63);
+}
+
+/**
+ * @brief OccupancyGrid::remove takes an entity off a tile. Nothing happens if the entity is not on the tile.
+ * @param x is the row of the tile
+ * @param y is the column of the tile
+ * @param i is the index of the entity
+ */
+void OccupancyGrid::remove(int x, int y, int i) {
+    if(!on_board(x, y)) {
+        return;
+    }
+
+    size_t c = cell(x, y);
+    int* link = &head[c];
+    while(*link != -1 && *link != i) {
+        link = &next[*link];
+    }
+
+    if(*link == i) {
+        *link = next[i];
+    }
+
+    if(head[c] == -1) {
+        bits[c >> 6] &= ~((uint64_t)1 << (c & 63));
+    }
+}
+
+/**
+ * @brief OccupancyGrid::rebuild indexes n entities from scratch. Called after every entity has moved.
+ * @param x holds the row of each entity
+ * @param y holds the column of each entity
+ * @param n is the number of entities
+ */
+void OccupancyGrid::rebuild(const int* x, const int* y, size_t n) {
+    clear();
+    next.resize(n);
+
+    for(size_t i = n; i-- > 0; ) {
+        insert(x[i], y[i], (int)i);
+    }
+}
+
+/**
+ * @brief OccupancyGrid::occupied checks the bitboard for a tile
+ * @param x is the row of the tile
+ * @param y is the column of the tile
+ * @return true if at least one entity is on the tile, false otherwise
+ */
+bool OccupancyGrid::occupied(int x, int y) const {
+    if(!on_board(x, y)) {
+        return false;
+    }
+
+    size_t c = cell(x, y);
+    return (bits[c >> 6] >> (c & 63)) & 1;
+}
+
+/**
+ * @brief OccupancyGrid::occupied_run reads the bitboard for a run of tiles in the same row at once
+ * @param c is the index of the first tile, the row times the number of columns plus the column
+ * @param count is the number of tiles, at most 32. The tiles must all be on the gameboard.
+ * @return bit k is set if the tile c + k is occupied
+ */
+unsigned OccupancyGrid::occupied_run(size_t c, int count) const {
+    size_t word = c >> 6;
+    unsigned offset = c & 63;
+
+    uint64_t run = bits[word] >> offset;
+    if(offset + count > 64) {
+        run |= bits[word + 1] << (64 - offset);
+    }
+    return (unsigned)(run & (((uint64_t)1 << count) - 1));
+}
+
+/**
+ * @brief OccupancyGrid::first_at finds the entity with the lowest index on a tile
+ * @param x is the row of the tile
+ * @param y is the column of the tile
+ * @return the index of the entity, or -1 if the tile is empty
+ */
+int OccupancyGrid::first_at(int x, int y) const {
+    if(!occupied(x, y)) {
+        return -1;
+    }
+
+    int first = head[cell(x, y)];
+    for(int i = next[first]; i != -1; i = next[i]) {
+        if(i < first) {
+            first = i;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief OccupancyGrid::list_at gets the first entity of the list of a tile. The rest of the list is walked
+ * with next_in_list(). The entities are in no particular order.
+ * @param x is the row of the tile
+ * @param y is the column of the tile
+ * @return the index of the entity, or -1 if the tile is empty
+ */
+int OccupancyGrid::list_at(int x, int y) const {
+    if(!occupied(x, y)) {
+        return -1;
+    }
+    return head[cell(x, y)];
+}
+
+/**
+ * @brief OccupancyGrid::list_at_cell gets the first entity of the list of a tile from the index of the tile, for
+ * the kernels that compute the index themselves with a FixedBoard.
+ * @param c is the index of the tile, the row times the number of columns plus the column. The tile must be on the gameboard.
+ * @return the index of the entity, or -1 if the tile is empty
+ */
+int OccupancyGrid::list_at_cell(size_t c) const {
+    return head[c];
+}
+
+/**
+ * @brief OccupancyGrid::next_in_list gets the entity after another one on the same tile
+ * @param i is the index of the entity
+ * @return the index of the next entity, or -1 at the end of the list
+ */
+int OccupancyGrid::next_in_list(int i) const {
+    return next[i];
+}
+
+/**
+ * @brief OccupancyGrid::compact_touched drops the tiles that were emptied by remove() from the list of touched
+ * tiles, and the tiles that are in it twice because they were emptied and filled again. Called when the list
+ * has grown to twice the number of entities, so it stays short when entities are moved one at a time.
+ */
+void OccupancyGrid::compact_touched() {
+    for(size_t c : touched) {
+        bits[c >> 6] &= ~((uint64_t)1 << (c & 63));
+    }
+
+    size_t kept = 0;
+    for(size_t c : touched) {
+        uint64_t bit = (uint64_t)1 << (c & 63);
+        if(head[c] != -1 && !(bits[c >> 6] & bit)) {
+            bits[c >> 6] |= bit;
+            touched[kept++] = c;
+        }
+    }
+    touched.resize(kept);
+}
+
+/**
+ * @brief OccupancyGrid::on_board checks that a tile is on the gameboard
+ * @return true if the tile is on the gameboard, false otherwise
+ */
+bool OccupancyGrid::on_board(int x, int y) const {
+    return x >= 0 && x < rows && y >= 0 && y < cols;
+}
+
+/**
+ * @brief OccupancyGrid::cell gets the position of a tile in the bitboard
+ * @return the index of the tile
+ */
+size_t OccupancyGrid::cell(int x, int y) const {
+    return (size_t)x * cols + y;
+}
@@ -0,0 +1,49 @@
+/** @file occupancygrid.h
+ *  @brief Class declaration for the OccupancyGrid class. Indexes which entities occupy each tile of the gameboard.
+ */
+
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The OccupancyGrid class keeps a bitboard with one bit per tile and, for each occupied tile, a list of the
+ * entities on it. Finding what occupies a tile is one lookup no matter how many entities exist.
+ * Locations outside of the gameboard are never indexed.
+ */
+class OccupancyGrid {
+public:
+    OccupancyGrid();
+
+    void resize(int rows, int cols);
+    void clear();
+
+    void insert(int x, int y, int i);
+    void remove(int x, int y, int i);
+    void rebuild(const int* x, const int* y, size_t n);
+
+    bool occupied(int x, int y) const;
+    unsigned occupied_run(size_t c, int count) const;
+    int first_at(int x, int y) const;
+    int list_at(int x, int y) const;
+    int list_at_cell(size_t c) const;
+    int next_in_list(int i) const;
+
+private:
+    bool on_board(int x, int y) const;
+    size_t cell(int x, int y) const;
+    void compact_touched();
+
+    int rows;
+    int cols;
+
+    std::vector<uint64_t> bits;
+    std::vector<int> head;
+    std::vector<int> next;
+    std::vector<size_t> touched;
+};
+
+#endif // OCCUPANCYGRID_H
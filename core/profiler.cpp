@@ -0,0 +1,249 @@
+/** @file profiler.cpp
+ *  @brief This file contains the definition of the Histogram, Profiler and ScopedTimer classes.
+ */
+
+#include "profiler.h"
+
+#include <iomanip>
+#include <sstream>
+
+/**
+ * @brief Histogram::Histogram constructs an empty histogram.
+ */
+Histogram::Histogram() {
+    reset();
+}
+
+/**
+ * @brief Histogram::bucket finds the bucket of a value. Values below SUB_BUCKETS have a bucket each; above that,
+ * each power of two is split into SUB_BUCKETS buckets by the bits that follow the highest set bit.
+ * @return the index of the bucket
+ */
+int Histogram::bucket(uint64_t value) {
+    if(value < SUB_BUCKETS) {
+        return (int)value;
+    }
+
+    int msb = 63;
+    while(!(value >> msb)) {
+        --msb;
+    }
+
+    int sub = (int)((value >> (msb - 3)) & (SUB_BUCKETS - 1));
+    int b = (msb - 2) * SUB_BUCKETS + sub;
+    return b < NUM_BUCKETS ? b : NUM_BUCKETS - 1;
+}
+
+/**
+ * @brief Histogram::lowest finds the smallest value that falls into a bucket
+ * @return the smallest value
+ */
+uint64_t Histogram::lowest(int bucket) {
+    if(bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+
+    int msb = bucket / SUB_BUCKETS + 2;
+    uint64_t sub = bucket % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub) << (msb - 3);
+}
+
+/**
+ * @brief Histogram::record counts a value
+ * @param value is the value
+ */
+void Histogram::record(uint64_t value) {
+    counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = largest.load(std::memory_order_relaxed);
+    while(value > seen && !largest.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Histogram::reset forgets every value.
+ */
+void Histogram::reset() {
+    for(int i = 0; i < NUM_BUCKETS; ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    largest.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Histogram::count gets the number of values recorded
+ * @return the number of values
+ */
+uint64_t Histogram::count() const {
+    return total.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Histogram::max gets the largest value recorded
+ * @return the largest value, exactly
+ */
+uint64_t Histogram::max() const {
+    return largest.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Histogram::percentile estimates a percentile as the middle of the bucket it falls in
+ * @param p is the percentile, between 0 and 100
+ * @return the estimate, or 0 if nothing was recorded
+ */
+uint64_t Histogram::percentile(double p) const {
+    uint64_t n = count();
+    if(n == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(p / 100.0 * n);
+    if(rank >= n) {
+        rank = n - 1;
+    }
+
+    uint64_t seen = 0;
+    for(int i = 0; i < NUM_BUCKETS; ++i) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if(seen > rank) {
+            uint64_t low = lowest(i);
+            uint64_t high = i + 1 < NUM_BUCKETS ? lowest(i + 1) : low;
+            uint64_t middle = low + (high - low) / 2;
+            return middle < max() ? middle : max();
+        }
+    }
+    return max();
+}
+
+/**
+ * @brief Profiler::phase_name gets the name of a phase, for the overlay and the summary
+ * @return the name
+ */
+const char* Profiler::phase_name(Phase phase) {
+    switch(phase) {
+    case(MOVE_ATTACK):
+        return "attack";
+    case(MOVE_ASTEROIDS):
+        return "asteroids";
+    case(RESOLVE_HITS):
+        return "hits";
+    case(INCREASE_ASTEROIDS):
+        return "spawn";
+    case(COLLIDE_ASTEROIDS):
+        return "collide";
+    case(TICK):
+        return "tick";
+    case(FRAME):
+        return "frame";
+    case(PAINT):
+        return "paint";
+    case(INPUT_LATENCY):
+        return "input lag";
+    case(FRAME_JITTER):
+        return "jitter";
+    case(ALLOCATIONS):
+        return "allocs/frame";
+    default:
+        return "";
+    }
+}
+
+/**
+ * @brief Profiler::Profiler constructs a profiler with empty histograms.
+ */
+Profiler::Profiler() : asteroids(0) {
+}
+
+/**
+ * @brief Profiler::reset empties every histogram. Called when a new game starts.
+ */
+void Profiler::reset() {
+    for(int i = 0; i < NUM_PHASES; ++i) {
+        phases[i].reset();
+    }
+    asteroids.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Profiler::record counts a value for a phase
+ * @param phase is the phase
+ * @param value is the duration in nanoseconds, or the number of allocations for ALLOCATIONS
+ */
+void Profiler::record(Phase phase, uint64_t value) {
+    phases[phase].record(value);
+}
+
+/**
+ * @brief Profiler::histogram gets the histogram of a phase
+ * @return a reference to the histogram
+ */
+const Histogram& Profiler::histogram(Phase phase) const {
+    return phases[phase];
+}
+
+/**
+ * @brief Profiler::set_entities stores the number of asteroids in the world
+ * @param asteroids is the number of asteroids
+ */
+void Profiler::set_entities(size_t asteroids) {
+    this->asteroids.store(asteroids, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Profiler::entities gets the number of asteroids in the world
+ * @return the number of asteroids
+ */
+size_t Profiler::entities() const {
+    return asteroids.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Profiler::summary writes the p50, p99 and max of every phase that was recorded, one phase per line.
+ * Durations are in microseconds.
+ * @return the summary
+ */
+std::string Profiler::summary() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << std::left << std::setw(14) << "phase" << std::right << std::setw(10) << "p50"
+        << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+    for(int i = 0; i < NUM_PHASES; ++i) {
+        const Histogram& h = phases[i];
+        if(h.count() == 0) {
+            continue;
+        }
+
+        double scale = i == ALLOCATIONS ? 1.0 : 1e-3;
+        out << std::left << std::setw(14) << phase_name((Phase)i) << std::right
+            << std::setw(10) << h.percentile(50) * scale
+            << std::setw(10) << h.percentile(99) * scale
+            << std::setw(10) << h.max() * scale << "\n";
+    }
+
+    out << "asteroids: " << entities();
+    return out.str();
+}
+
+/**
+ * @brief ScopedTimer::ScopedTimer starts measuring a phase
+ * @param profiler is the profiler to record into, or null to measure nothing
+ * @param phase is the phase
+ */
+ScopedTimer::ScopedTimer(Profiler* profiler, Profiler::Phase phase) : profiler(profiler), phase(phase) {
+    if(profiler != nullptr) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+/**
+ * @brief ScopedTimer::~ScopedTimer records the time since the timer was constructed.
+ */
+ScopedTimer::~ScopedTimer() {
+    if(profiler != nullptr) {
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        profiler->record(phase, elapsed.count());
+    }
+}
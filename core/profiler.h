@@ -0,0 +1,100 @@
+/** @file profiler.h
+ *  @brief Class declarations for the Histogram, Profiler and ScopedTimer classes, which measure how long each
+ *         phase of a tick and a frame takes.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief The Histogram class counts values in buckets that grow with the value, eight buckets per power of two,
+ * so any percentile is known to within 12.5%. Recording is lock-free and may happen on any thread.
+ */
+class Histogram {
+public:
+    static const int SUB_BUCKETS = 8;
+    static const int NUM_BUCKETS = 62 * SUB_BUCKETS;
+
+    Histogram();
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t count() const;
+    uint64_t max() const;
+    uint64_t percentile(double p) const;
+
+private:
+    static int bucket(uint64_t value);
+    static uint64_t lowest(int bucket);
+
+    std::atomic<uint64_t> counts[NUM_BUCKETS];
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> largest;
+};
+
+/**
+ * @brief The Profiler class keeps a Histogram for every phase of a tick and a frame, in nanoseconds, the time from
+ * an input to the first frame painted with it, the frame jitter, the number of allocations per frame and the number
+ * of entities.
+ */
+class Profiler {
+public:
+    /**
+     * @brief The Phase enum lists what the profiler measures.
+     */
+    enum Phase {
+        MOVE_ATTACK = 0,
+        MOVE_ASTEROIDS,
+        RESOLVE_HITS,
+        INCREASE_ASTEROIDS,
+        COLLIDE_ASTEROIDS,
+        TICK,
+        FRAME,
+        PAINT,
+        INPUT_LATENCY,
+        FRAME_JITTER,
+        ALLOCATIONS,
+        NUM_PHASES
+    };
+
+    static const char* phase_name(Phase phase);
+
+    Profiler();
+
+    void reset();
+    void record(Phase phase, uint64_t value);
+    const Histogram& histogram(Phase phase) const;
+
+    void set_entities(size_t asteroids);
+    size_t entities() const;
+
+    std::string summary() const;
+
+private:
+    Histogram phases[NUM_PHASES];
+    std::atomic<size_t> asteroids;
+};
+
+/**
+ * @brief The ScopedTimer class records the time between its construction and destruction for one phase.
+ * Nothing is measured when the profiler is null.
+ */
+class ScopedTimer {
+public:
+    ScopedTimer(Profiler* profiler, Profiler::Phase phase);
+    ~ScopedTimer();
+
+private:
+    Profiler* profiler;
+    Profiler::Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // PROFILER_H
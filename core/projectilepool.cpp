@@ -0,0 +1,183 @@
+/** @file projectilepool.cpp
+ *  @brief This file contains the definition of the ProjectilePool class.
+ */
+
+#include "projectilepool.h"
+
+#include <cstring>
+
+/**
+ * @brief ProjectilePool::ProjectilePool creates a pool with room for one shot.
+ */
+ProjectilePool::ProjectilePool() : count(0) {
+    set_capacity(1);
+}
+
+/**
+ * @brief ProjectilePool::set_capacity changes the number of shots that can be in flight at once.
+ * Every shot is removed. Nothing is allocated if the capacity does not change.
+ * @param capacity is the number of shots, at least 1
+ */
+void ProjectilePool::set_capacity(size_t capacity) {
+    if(capacity == 0) {
+        capacity = 1;
+    }
+
+    x.resize(capacity);
+    y.resize(capacity);
+    xDir.resize(capacity);
+    yDir.resize(capacity);
+    count = 0;
+}
+
+/**
+ * @brief ProjectilePool::capacity gets the number of shots that can be in flight at once
+ * @return the capacity
+ */
+size_t ProjectilePool::capacity() const {
+    return x.size();
+}
+
+/**
+ * @brief ProjectilePool::size gets the number of shots in flight
+ * @return the number of shots
+ */
+size_t ProjectilePool::size() const {
+    return count;
+}
+
+/**
+ * @brief ProjectilePool::full checks if no other shot can be fired
+ * @return true if the pool is full, false otherwise
+ */
+bool ProjectilePool::full() const {
+    return count == x.size();
+}
+
+/**
+ * @brief ProjectilePool::clear removes every shot.
+ */
+void ProjectilePool::clear() {
+    count = 0;
+}
+
+/**
+ * @brief ProjectilePool::fire adds a shot
+ * @param x is the row the shot starts on
+ * @param y is the column the shot starts on
+ * @param x_dir is the number of rows the shot moves each time it moves
+ * @param y_dir is the number of columns the shot moves each time it moves
+ * @return true if the shot was added, false if the pool is full
+ */
+bool ProjectilePool::fire(int x, int y, int x_dir, int y_dir) {
+    if(full()) {
+        return false;
+    }
+
+    this->x[count] = x;
+    this->y[count] = y;
+    xDir[count] = x_dir;
+    yDir[count] = y_dir;
+    ++count;
+    return true;
+}
+
+/**
+ * @brief ProjectilePool::remove takes a shot out of flight. The last shot takes its index.
+ * @param i is the index of the shot
+ */
+void ProjectilePool::remove(size_t i) {
+    --count;
+    x[i] = x[count];
+    y[i] = y[count];
+    xDir[i] = xDir[count];
+    yDir[i] = yDir[count];
+}
+
+/**
+ * @brief ProjectilePool::move moves every shot by one tile in its direction.
+ */
+void ProjectilePool::move() {
+    for(size_t i = 0; i < count; ++i) {
+        x[i] += xDir[i];
+        y[i] += yDir[i];
+    }
+}
+
+/**
+ * @brief ProjectilePool::getX gets the row of a shot
+ * @param i is the index of the shot
+ * @return the row
+ */
+int ProjectilePool::getX(size_t i) const {
+    return x[i];
+}
+
+/**
+ * @brief ProjectilePool::getY gets the column of a shot
+ * @param i is the index of the shot
+ * @return the column
+ */
+int ProjectilePool::getY(size_t i) const {
+    return y[i];
+}
+
+/**
+ * @brief ProjectilePool::getXdir gets the number of rows a shot moves each time it moves
+ * @param i is the index of the shot
+ * @return -1, 0 or 1
+ */
+int ProjectilePool::getXdir(size_t i) const {
+    return xDir[i];
+}
+
+/**
+ * @brief ProjectilePool::getYdir gets the number of columns a shot moves each time it moves
+ * @param i is the index of the shot
+ * @return -1, 0 or 1
+ */
+int ProjectilePool::getYdir(size_t i) const {
+    return yDir[i];
+}
+
+/**
+ * @brief ProjectilePool::state_size gets the number of bytes save_state() writes
+ * @return four ints per shot in flight
+ */
+size_t ProjectilePool::state_size() const {
+    return 4 * sizeof(int) * count;
+}
+
+/**
+ * @brief ProjectilePool::save_state copies the position and direction of every shot in flight, one array after
+ * the other.
+ * @param out receives state_size() bytes
+ */
+void ProjectilePool::save_state(unsigned char* out) const {
+    size_t bytes = sizeof(int) * count;
+    std::memcpy(out, x.data(), bytes);
+    std::memcpy(out + bytes, y.data(), bytes);
+    std::memcpy(out + 2 * bytes, xDir.data(), bytes);
+    std::memcpy(out + 3 * bytes, yDir.data(), bytes);
+}
+
+/**
+ * @brief ProjectilePool::restore_state replaces the shots in flight with the ones saved by save_state().
+ * The capacity does not change, so nothing is allocated.
+ * @param in holds the bytes written by save_state()
+ * @param n is the number of shots that were saved
+ * @return false if the shots do not fit in the pool, in which case the pool is left as it was
+ */
+bool ProjectilePool::restore_state(const unsigned char* in, size_t n) {
+    if(n > x.size()) {
+        return false;
+    }
+
+    size_t bytes = sizeof(int) * n;
+    std::memcpy(x.data(), in, bytes);
+    std::memcpy(y.data(), in + bytes, bytes);
+    std::memcpy(xDir.data(), in + 2 * bytes, bytes);
+    std::memcpy(yDir.data(), in + 3 * bytes, bytes);
+    count = n;
+    return true;
+}
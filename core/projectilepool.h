@@ -0,0 +1,49 @@
+/** @file projectilepool.h
+ *  @brief Class declaration for the ProjectilePool class. Stores every shot in flight as a structure of arrays.
+ */
+
+#ifndef PROJECTILEPOOL_H
+#define PROJECTILEPOOL_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The ProjectilePool class holds the position and direction of every shot in flight. The storage is
+ * allocated once for the largest number of shots, so firing and removing shots never allocates. A shot is
+ * identified by its index, which changes when a shot before it is removed.
+ */
+class ProjectilePool {
+public:
+    ProjectilePool();
+
+    void set_capacity(size_t capacity);
+    size_t capacity() const;
+
+    size_t size() const;
+    bool full() const;
+    void clear();
+
+    bool fire(int x, int y, int x_dir, int y_dir);
+    void remove(size_t i);
+    void move();
+
+    int getX(size_t i) const;
+    int getY(size_t i) const;
+    int getXdir(size_t i) const;
+    int getYdir(size_t i) const;
+
+    size_t state_size() const;
+    void save_state(unsigned char* out) const;
+    bool restore_state(const unsigned char* in, size_t n);
+
+private:
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> xDir;
+    std::vector<int> yDir;
+
+    size_t count;
+};
+
+#endif // PROJECTILEPOOL_H
@@ -0,0 +1,300 @@
+/** @file recording.cpp
+ *  @brief This file contains the definition of the Recording class.
+ */
+
+#include "recording.h"
+
+#include <algorithm>
+#include <fstream>
+
+static const char MAGIC[4] = { 'A', 'S', 'T', 'R' };
+static const unsigned char VERSION = 5;
+static const unsigned char MILLISECOND_VERSION = 4;
+static const unsigned char TICK_VERSION = 3;
+
+/**
+ * @brief write_varint writes an unsigned integer seven bits at a time, lowest bits first.
+ */
+static void write_varint(std::ostream& out, uint64_t value) {
+    while(value >= 0x80) {
+        out.put((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.put((char)value);
+}
+
+/**
+ * @brief read_varint reads an integer written by write_varint
+ * @return false if the stream ended or the integer is too long
+ */
+static bool read_varint(std::istream& in, uint64_t& value) {
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7) {
+        int c = in.get();
+        if(c == EOF) {
+            return false;
+        }
+        value |= (uint64_t)(c & 0x7f) << shift;
+        if(!(c & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief read_int reads a variable length integer into an int
+ * @return false if the stream ended
+ */
+static bool read_int(std::istream& in, int& value) {
+    uint64_t v;
+    if(!read_varint(in, v)) {
+        return false;
+    }
+    value = (int)v;
+    return true;
+}
+
+/**
+ * @brief Recording::Recording constructs an empty recording.
+ */
+Recording::Recording() {
+    start(World::Settings(), 10);
+}
+
+/**
+ * @brief Recording::start begins recording a new game. Inputs of the previous game are discarded.
+ * @param settings are the settings the game is played with, including the seed
+ * @param tick_length is the number of milliseconds in one tick of the game loop
+ */
+void Recording::start(const World::Settings& settings, int tick_length) {
+    config = settings;
+    tickLength = tick_length;
+    inputs.clear();
+    finalTicks = 0;
+    asteroids_hit = 0;
+    shots_fired = 0;
+}
+
+/**
+ * @brief Recording::record adds an input to the recording
+ * @param time is the game time in milliseconds at which the input was applied
+ * @param input is the input
+ */
+void Recording::record(long long time, World::Input input) {
+    Event e;
+    e.time = time;
+    e.input = input;
+    inputs.push_back(e);
+}
+
+/**
+ * @brief Recording::finish stores the final score of the game
+ * @param world is the world once the game is over
+ * @param ticks is the number of ticks the game ran for
+ */
+void Recording::finish(const World& world, long long ticks) {
+    finalTicks = ticks;
+    asteroids_hit = world.num_asteroids_hit();
+    shots_fired = world.num_shots_fired();
+}
+
+/**
+ * @brief Recording::save writes the recording to a file
+ * @param path is the name of the file
+ * @return true if the file was written, false otherwise
+ */
+bool Recording::save(const std::string& path) const {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if(!out) {
+        return false;
+    }
+
+    out.write(MAGIC, sizeof(MAGIC));
+    out.put((char)VERSION);
+
+    write_varint(out, config.grid_width);
+    write_varint(out, config.grid_length);
+    write_varint(out, config.num_asteroids);
+    write_varint(out, config.asteroid_speed);
+    write_varint(out, config.asteroid_step);
+    write_varint(out, config.asteroid_speed_spread);
+    write_varint(out, config.rate_of_num_astr_increase);
+    write_varint(out, config.ship_x);
+    write_varint(out, config.ship_y);
+    write_varint(out, config.attack_speed);
+    write_varint(out, config.max_projectiles);
+    write_varint(out, config.asteroid_fragments);
+    write_varint(out, config.asteroid_collisions);
+    write_varint(out, config.seed);
+    write_varint(out, tickLength);
+
+    write_varint(out, finalTicks);
+    write_varint(out, asteroids_hit);
+    write_varint(out, shots_fired);
+
+    write_varint(out, inputs.size());
+    long long previous = 0;
+    for(const auto& e : inputs) {
+        write_varint(out, (uint64_t)(e.time - previous) << 2 | e.input);
+        previous = e.time;
+    }
+
+    return (bool)out;
+}
+
+/**
+ * @brief Recording::load reads a recording written by save(). The inputs of a version 3 recording happened
+ * between ticks, so the tick they were counted in is turned into its game time. Recordings older than version 5
+ * were played without fragments and collisions, and are loaded with both turned off. A recording whose periods or
+ * tick length are not positive is rejected, since it could only have been corrupted or edited and would never end.
+ * @param path is the name of the file
+ * @return true if the file held a valid recording, false otherwise
+ */
+bool Recording::load(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if(!in) {
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)];
+    if(!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+        return false;
+    }
+    int version = in.get();
+    if(version != VERSION && version != MILLISECOND_VERSION && version != TICK_VERSION) {
+        return false;
+    }
+
+    World::Settings settings;
+    uint64_t ticks, hit, fired, count;
+    int tick_length;
+    int collisions = 0;
+    settings.asteroid_fragments = 0;
+
+    if(!read_int(in, settings.grid_width) || !read_int(in, settings.grid_length)
+            || !read_int(in, settings.num_asteroids) || !read_int(in, settings.asteroid_speed)
+            || !read_int(in, settings.asteroid_step) || !read_int(in, settings.asteroid_speed_spread)
+            || !read_int(in, settings.rate_of_num_astr_increase) || !read_int(in, settings.ship_x)
+            || !read_int(in, settings.ship_y) || !read_int(in, settings.attack_speed)
+            || !read_int(in, settings.max_projectiles)
+            || (version == VERSION && (!read_int(in, settings.asteroid_fragments) || !read_int(in, collisions)))
+            || !read_varint(in, settings.seed) || !read_int(in, tick_length)
+            || !read_varint(in, ticks) || !read_varint(in, hit) || !read_varint(in, fired)
+            || !read_varint(in, count)) {
+        return false;
+    }
+    if(settings.asteroid_step <= 0 || settings.attack_speed <= 0 || settings.rate_of_num_astr_increase <= 0
+            || tick_length <= 0) {
+        return false;
+    }
+    settings.asteroid_collisions = collisions != 0;
+
+    start(settings, tick_length);
+    finalTicks = ticks;
+    asteroids_hit = hit;
+    shots_fired = fired;
+
+    long long unit = version == TICK_VERSION ? tick_length : 1;
+    long long time = 0;
+    for(uint64_t i = 0; i < count; ++i) {
+        uint64_t packed;
+        if(!read_varint(in, packed) || (packed & 3) > World::FIRE) {
+            return false;
+        }
+        time += (packed >> 2) * unit;
+        record(time, (World::Input)(packed & 3));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Recording::replay plays the recorded game again as fast as possible. The world is stepped a tick at a time,
+ * and a tick that holds inputs is split at the game time of each of them, so every input is applied at the same
+ * game time as when it was recorded and the world ends in the same state as the recorded game.
+ * @param world is the world to play the game in. It is reset with the recorded settings.
+ * @param after_tick is called with the number of ticks that have run after the world is reset and after every tick,
+ * for example to draw the frames of the game. It may be empty.
+ * @return true if the replay ended with the recorded number of ticks and the recorded score, false otherwise
+ */
+bool Recording::replay(World& world, const std::function<void(long long)>& after_tick) const {
+    world.set_settings(config);
+    world.reset();
+    if(after_tick) {
+        after_tick(0);
+    }
+
+    size_t next = 0;
+    long long tick = 0;
+
+    for(;; ++tick) {
+        long long end = (tick + 1) * tickLength;
+        while(next < inputs.size() && inputs[next].time < end && !world.is_over()) {
+            if(inputs[next].time > world.elapsed()) {
+                world.step((int)(inputs[next].time - world.elapsed()));
+            }
+            world.apply(inputs[next].input);
+            ++next;
+        }
+
+        if(world.is_over() || tick == finalTicks) {
+            break;
+        }
+
+        world.step((int)(end - world.elapsed()));
+        if(after_tick) {
+            after_tick(tick + 1);
+        }
+    }
+
+    return tick == finalTicks && world.num_asteroids_hit() == asteroids_hit && world.num_shots_fired() == shots_fired;
+}
+
+/**
+ * @brief Recording::settings gets the settings of the recorded game
+ * @return the settings
+ */
+const World::Settings& Recording::settings() const {
+    return config;
+}
+
+/**
+ * @brief Recording::tick_length gets the length of a tick of the recorded game
+ * @return the number of milliseconds in one tick
+ */
+int Recording::tick_length() const {
+    return tickLength;
+}
+
+/**
+ * @brief Recording::events gets the recorded inputs
+ * @return the inputs, in the order they happened
+ */
+const std::vector<Recording::Event>& Recording::events() const {
+    return inputs;
+}
+
+/**
+ * @brief Recording::ticks gets the number of ticks the recorded game ran for
+ * @return the number of ticks
+ */
+long long Recording::ticks() const {
+    return finalTicks;
+}
+
+/**
+ * @brief Recording::num_asteroids_hit gets the number of asteroids destroyed in the recorded game
+ * @return the number of asteroids hit
+ */
+size_t Recording::num_asteroids_hit() const {
+    return asteroids_hit;
+}
+
+/**
+ * @brief Recording::num_shots_fired gets the number of attacks launched in the recorded game
+ * @return the number of shots fired
+ */
+size_t Recording::num_shots_fired() const {
+    return shots_fired;
+}
@@ -0,0 +1,62 @@
+/** @file recording.h
+ *  @brief Class declaration for the Recording class. Records the inputs of a game so it can be replayed headless.
+ */
+
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include "world.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The Recording class holds everything needed to play a game again: the settings including the seed,
+ * the length of a tick, and every input with the game time in milliseconds at which it was applied. It also holds
+ * the final score, so a replay can check that it reproduced the game.
+ *
+ * The file format is compact: a short header, then one variable length integer per input holding the number
+ * of milliseconds since the previous input and the input itself. Recordings of version 3, which counted ticks
+ * instead of milliseconds, and of version 4, which had no fragments or collisions, can still be loaded.
+ */
+class Recording {
+public:
+    /**
+     * @brief The Event struct is one input of the player.
+     */
+    struct Event {
+        long long time;
+        World::Input input;
+    };
+
+    Recording();
+
+    void start(const World::Settings& settings, int tick_length);
+    void record(long long time, World::Input input);
+    void finish(const World& world, long long ticks);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    bool replay(World& world, const std::function<void(long long)>& after_tick = nullptr) const;
+
+    const World::Settings& settings() const;
+    int tick_length() const;
+    const std::vector<Event>& events() const;
+    long long ticks() const;
+    size_t num_asteroids_hit() const;
+    size_t num_shots_fired() const;
+
+private:
+    World::Settings config;
+    int tickLength;
+    std::vector<Event> inputs;
+
+    long long finalTicks;
+    size_t asteroids_hit;
+    size_t shots_fired;
+};
+
+#endif // RECORDING_H
@@ -0,0 +1,80 @@
+/** @file rng.cpp
+ *  @brief This file contains the definition of the Rng class.
+ */
+
+#include "rng.h"
+
+#include <cmath>
+
+/**
+ * @brief Rng::Rng constructs a generator from a seed
+ * @param seed is the seed, any value is allowed
+ */
+Rng::Rng(uint64_t seed) {
+    this->seed(seed);
+}
+
+/**
+ * @brief Rng::seed restarts the generator. The seed is scrambled with splitmix64 so that similar seeds
+ * (such as consecutive timestamps) give unrelated sequences and a seed of zero is allowed.
+ * @param seed is the seed
+ */
+void Rng::seed(uint64_t seed) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+    s = z != 0 ? z : 0x9E3779B97F4A7C15ull;
+}
+
+/**
+ * @brief Rng::state gets the internal state of the generator
+ * @return the state
+ */
+uint64_t Rng::state() const {
+    return s;
+}
+
+/**
+ * @brief Rng::set_state restores a state given by state()
+ * @param state is the state, which must not be zero
+ */
+void Rng::set_state(uint64_t state) {
+    s = state;
+}
+
+/**
+ * @brief Rng::next gets the next 64 random bits
+ * @return the random bits
+ */
+uint64_t Rng::next() {
+    s ^= s >> 12;
+    s ^= s << 25;
+    s ^= s >> 27;
+    return s * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * @brief Rng::uniform picks an integer uniformly from [low, high]
+ * @return the random integer
+ */
+int Rng::uniform(int low, int high) {
+    uint64_t range = (uint64_t)((int64_t)high - low + 1);
+    return (int)(low + (int64_t)(((next() >> 32) * range) >> 32));
+}
+
+/**
+ * @brief Rng::normal picks a number from a normal distribution with the Box-Muller transform
+ * @param mean is the mean of the distribution
+ * @param stddev is the standard deviation of the distribution
+ * @return the random number
+ */
+double Rng::normal(double mean, double stddev) {
+    const double two_pi = 6.283185307179586;
+
+    // 53 random bits in (0, 1], so the logarithm is finite
+    double u1 = ((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    double u2 = (next() >> 11) * (1.0 / 9007199254740992.0);
+
+    return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(two_pi * u2);
+}
@@ -0,0 +1,31 @@
+/** @file rng.h
+ *  @brief Class declaration for the Rng class. A small random number generator whose output is the same on every
+ *         platform, so that a game can be reproduced from its seed.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+/**
+ * @brief The Rng class is a xorshift64* generator. Unlike the distributions of the standard library,
+ * uniform() and normal() give the same sequence with every compiler and standard library.
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 0);
+
+    void seed(uint64_t seed);
+    uint64_t state() const;
+    void set_state(uint64_t state);
+
+    uint64_t next();
+    int uniform(int low, int high);
+    double normal(double mean, double stddev);
+
+private:
+    uint64_t s;
+};
+
+#endif // RNG_H
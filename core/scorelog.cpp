@@ -0,0 +1,350 @@
+/** @file scorelog.cpp
+ *  @brief This file contains the definition of the ScoreLog class.
+ */
+
+#include "scorelog.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SCORELOG_MMAP 1
+#endif
+
+static const char MAGIC[8] = { 'A', 'S', 'T', 'R', 'S', 'C', 'O', 'R' };
+static const uint32_t VERSION = 1;
+
+static const size_t HEADER_SIZE = 4096;
+static const size_t GROW_RECORDS = 1 << 16;
+
+/**
+ * @brief The ScoreLog::Record struct is one score in the file, followed by the checksum of the score.
+ */
+struct ScoreLog::Record {
+    Score score;
+    uint64_t checksum;
+};
+
+/**
+ * @brief The ScoreLog::Header struct is the first page of the file. It holds how many scores the best scores
+ * were taken from, the best scores themselves and the checksum of everything before it.
+ */
+struct ScoreLog::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+    uint64_t num_top;
+    Score top[TOP_K];
+    uint64_t checksum;
+};
+
+static_assert(sizeof(ScoreLog::Score) == 32, "a score has no padding");
+
+/**
+ * @brief checksum hashes bytes with 64 bit FNV-1a. Bytes that are all zero do not hash to zero, so a slot that was
+ * never written is never taken for a score.
+ */
+static uint64_t checksum(const void* bytes, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < size; ++i) {
+        hash = (hash ^ p[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief ScoreLog::ScoreLog is the constructor for the ScoreLog class. The log is closed until open() is called.
+ */
+ScoreLog::ScoreLog() : fd(-1), data(nullptr), mapped(0), capacity(0), count(0) {
+    static_assert(sizeof(Header) <= HEADER_SIZE, "the header fits in the first page");
+}
+
+/**
+ * @brief ScoreLog::~ScoreLog closes the log.
+ */
+ScoreLog::~ScoreLog() {
+    close();
+}
+
+/**
+ * @brief ScoreLog::open opens a log, or creates it if the file does not exist or is empty. The scores appended since
+ * the first page was last written are checked and ranked; a score that fails its checksum ends the log. Any other
+ * file is left untouched. The file is locked until the log is closed, so that two processes never append to it at
+ * the same time; a log that another process has open is not opened.
+ * @param path is the name of the file
+ * @return false if the file could not be opened, is not a score log or is in use by another process
+ */
+bool ScoreLog::open(const std::string& path) {
+    close();
+
+#ifdef SCORELOG_MMAP
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if(fd < 0) {
+        return false;
+    }
+    if(flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close();
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(fd, &info) != 0) {
+        close();
+        return false;
+    }
+
+    size_t bytes = info.st_size;
+    bool fresh = bytes == 0;
+    if(!fresh && bytes < HEADER_SIZE) {
+        close();
+        return false;
+    }
+    if(fresh) {
+        bytes = HEADER_SIZE + GROW_RECORDS * sizeof(Record);
+        if(ftruncate(fd, bytes) != 0) {
+            close();
+            return false;
+        }
+    }
+    if(!map(bytes)) {
+        close();
+        return false;
+    }
+
+    Header* h = header();
+    if(fresh || std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        static const Header EMPTY = Header();
+        if(!fresh && std::memcmp(h, &EMPTY, sizeof(Header)) != 0) {
+            close();
+            return false;
+        }
+        std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+        h->version = VERSION;
+        h->record_size = sizeof(Record);
+        h->count = 0;
+        h->num_top = 0;
+        h->checksum = 0;
+    }
+    if(h->version != VERSION || h->record_size != sizeof(Record)) {
+        close();
+        return false;
+    }
+
+    scan();
+    write_header();
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+/**
+ * @brief ScoreLog::close unmaps and closes the file, which releases the lock on it. Scores that were appended stay in it.
+ */
+void ScoreLog::close() {
+#ifdef SCORELOG_MMAP
+    if(data != nullptr) {
+        munmap(data, mapped);
+    }
+    if(fd >= 0) {
+        ::close(fd);
+    }
+#endif
+    fd = -1;
+    data = nullptr;
+    mapped = 0;
+    capacity = 0;
+    count = 0;
+    best.clear();
+}
+
+/**
+ * @brief ScoreLog::is_open
+ * @return true if scores can be appended
+ */
+bool ScoreLog::is_open() const {
+    return data != nullptr;
+}
+
+/**
+ * @brief ScoreLog::append adds a score to the end of the log and to the best scores if it is good enough. The file
+ * grows by GROW_RECORDS scores at a time; nothing else touches the disk.
+ * @param score is the score
+ * @return false if the log is closed or could not grow
+ */
+bool ScoreLog::append(const Score& score) {
+    if(!is_open() || (count == capacity && !grow())) {
+        return false;
+    }
+
+    Record& record = records()[count];
+    record.score = score;
+    record.checksum = checksum(&record.score, sizeof(Score));
+    ++count;
+
+    rank(score);
+    write_header();
+    return true;
+}
+
+/**
+ * @brief ScoreLog::size
+ * @return the number of scores in the log
+ */
+size_t ScoreLog::size() const {
+    return count;
+}
+
+/**
+ * @brief ScoreLog::at gets a score, in the order they were appended
+ * @param i is the index of the score, less than size()
+ * @return the score
+ */
+const ScoreLog::Score& ScoreLog::at(size_t i) const {
+    return records()[i].score;
+}
+
+/**
+ * @brief ScoreLog::top gets the best scores
+ * @return up to TOP_K scores, the best first
+ */
+const std::vector<ScoreLog::Score>& ScoreLog::top() const {
+    return best;
+}
+
+/**
+ * @brief ScoreLog::better orders scores. More asteroids destroyed is better, then fewer shots fired, then the
+ * earlier game.
+ * @return true if a ranks above b
+ */
+bool ScoreLog::better(const Score& a, const Score& b) {
+    if(a.asteroids_hit != b.asteroids_hit) {
+        return a.asteroids_hit > b.asteroids_hit;
+    }
+    if(a.shots_fired != b.shots_fired) {
+        return a.shots_fired < b.shots_fired;
+    }
+    return a.time < b.time;
+}
+
+/**
+ * @brief ScoreLog::map maps the file into memory
+ * @param bytes is the size of the file
+ * @return false if it could not be mapped
+ */
+bool ScoreLog::map(size_t bytes) {
+#ifdef SCORELOG_MMAP
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(address == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<unsigned char*>(address);
+    mapped = bytes;
+    capacity = (bytes - HEADER_SIZE) / sizeof(Record);
+    return true;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+/**
+ * @brief ScoreLog::grow makes room for GROW_RECORDS more scores and maps the file again.
+ * @return false if the file could not grow, in which case the log is closed
+ */
+bool ScoreLog::grow() {
+#ifdef SCORELOG_MMAP
+    size_t bytes = HEADER_SIZE + (capacity + GROW_RECORDS) * sizeof(Record);
+    munmap(data, mapped);
+    data = nullptr;
+    if(ftruncate(fd, bytes) != 0 || !map(bytes)) {
+        close();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief ScoreLog::scan finds the end of the log and ranks the scores the first page does not cover yet.
+ * The best scores of the first page are used if its checksum holds and the last score it covers is intact;
+ * otherwise every score is ranked again. Every leftover after the end is cleared, including the ones past a gap of
+ * records that were never written, so a score appended later is never followed by an older one. Only the records
+ * that are not already zero are written.
+ */
+void ScoreLog::scan() {
+    const Header* h = header();
+    Record* r = records();
+
+    count = 0;
+    best.clear();
+    if(h->checksum == checksum(h, offsetof(Header, checksum)) && h->count <= capacity && h->num_top <= TOP_K &&
+       (h->count == 0 || r[h->count - 1].checksum == checksum(&r[h->count - 1].score, sizeof(Score)))) {
+        count = h->count;
+        best.assign(h->top, h->top + h->num_top);
+    }
+
+    while(count < capacity && r[count].checksum == checksum(&r[count].score, sizeof(Score))) {
+        rank(r[count].score);
+        ++count;
+    }
+
+    static const Record EMPTY = Record();
+    for(size_t i = count; i < capacity; ++i) {
+        if(std::memcmp(&r[i], &EMPTY, sizeof(Record)) != 0) {
+            r[i] = EMPTY;
+        }
+    }
+}
+
+/**
+ * @brief ScoreLog::rank puts a score among the best scores if it is good enough
+ * @param score is the score
+ */
+void ScoreLog::rank(const Score& score) {
+    std::vector<Score>::iterator position = std::upper_bound(best.begin(), best.end(), score, better);
+    if(position - best.begin() >= (std::ptrdiff_t)TOP_K) {
+        return;
+    }
+    best.insert(position, score);
+    if(best.size() > TOP_K) {
+        best.pop_back();
+    }
+}
+
+/**
+ * @brief ScoreLog::write_header writes the number of scores and the best scores to the first page.
+ */
+void ScoreLog::write_header() {
+    Header* h = header();
+    h->count = count;
+    h->num_top = best.size();
+    std::copy(best.begin(), best.end(), h->top);
+    h->checksum = checksum(h, offsetof(Header, checksum));
+}
+
+/**
+ * @brief ScoreLog::header
+ * @return the first page of the file
+ */
+ScoreLog::Header* ScoreLog::header() const {
+    return reinterpret_cast<Header*>(data);
+}
+
+/**
+ * @brief ScoreLog::records
+ * @return the scores, which start after the first page
+ */
+ScoreLog::Record* ScoreLog::records() const {
+    return reinterpret_cast<Record*>(data + HEADER_SIZE);
+}
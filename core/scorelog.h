@@ -0,0 +1,78 @@
+/** @file scorelog.h
+ *  @brief Class declaration for the ScoreLog class. Keeps the score of every game played in an append-only,
+ *         memory-mapped file together with the best scores.
+ */
+
+#ifndef SCORELOG_H
+#define SCORELOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The ScoreLog class appends the score of every game to a file that is mapped into memory, and keeps the
+ * TOP_K best scores up to date as scores are appended. The best scores are stored in the first page of the file,
+ * so opening a log only reads that page and the scores appended since it was last written, however many games the
+ * log holds.
+ *
+ * Nothing is flushed to disk explicitly. Every score and the first page carry a checksum instead: a score that was
+ * only partly written when the process or the machine stopped is found on the next open and dropped along with
+ * everything after it, and a first page that was only partly written is rebuilt from the scores.
+ *
+ * Only one ScoreLog at a time, in any process, can have a file open; the others fail to open it until it is closed.
+ * The file is only meant to be read on the kind of machine that wrote it. Logs are supported on Linux and macOS.
+ */
+class ScoreLog {
+public:
+    static const size_t TOP_K = 10;
+
+    /**
+     * @brief The Score struct is the result of one game.
+     */
+    struct Score {
+        uint64_t time;
+        uint64_t seed;
+        uint64_t elapsed;
+        uint32_t asteroids_hit;
+        uint32_t shots_fired;
+    };
+
+    ScoreLog();
+    ~ScoreLog();
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const;
+
+    bool append(const Score& score);
+
+    size_t size() const;
+    const Score& at(size_t i) const;
+    const std::vector<Score>& top() const;
+
+    static bool better(const Score& a, const Score& b);
+
+private:
+    struct Record;
+    struct Header;
+
+    bool map(size_t bytes);
+    bool grow();
+    void scan();
+    void rank(const Score& score);
+    void write_header();
+
+    Header* header() const;
+    Record* records() const;
+
+    int fd;
+    unsigned char* data;
+    size_t mapped;
+    size_t capacity;
+    size_t count;
+    std::vector<Score> best;
+};
+
+#endif // SCORELOG_H
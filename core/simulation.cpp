@@ -0,0 +1,181 @@
+/** @file simulation.cpp
+ *  @brief This file contains the definition of the Simulation class.
+ */
+
+#include "simulation.h"
+
+#include <algorithm>
+
+/**
+ * @brief Simulation::Simulation is the constructor for the Simulation class. The thread is not started.
+ * @param world is the world to step
+ * @param loop is the game loop that steps the world
+ */
+Simulation::Simulation(World* world, GameLoop* loop)
+    : world(world), loop(loop), recording(nullptr), viewRows(23), viewCols(23), inputHead(0), inputTail(0), lastInput(0), running(false) {
+}
+
+/**
+ * @brief Simulation::~Simulation stops the thread.
+ */
+Simulation::~Simulation() {
+    stop();
+}
+
+/**
+ * @brief Simulation::set_view changes the number of tiles each snapshot holds. Takes effect at the next start().
+ * @param rows is the number of visible rows
+ * @param cols is the number of visible columns
+ */
+void Simulation::set_view(int rows, int cols) {
+    viewRows = rows;
+    viewCols = cols;
+}
+
+/**
+ * @brief Simulation::set_recording makes every input get recorded when it is applied
+ * @param recording is the recording, or null to stop recording
+ */
+void Simulation::set_recording(Recording* recording) {
+    this->recording = recording;
+}
+
+/**
+ * @brief Simulation::start publishes a snapshot of the world as it is and starts stepping it on the thread.
+ * The world and the game loop should have been reset. Inputs left over from the last game are dropped.
+ */
+void Simulation::start() {
+    stop();
+
+    inputTail.store(inputHead.load());
+    lastInput = 0;
+    publish();
+
+    running.store(true);
+    thread = std::thread(&Simulation::run, this);
+}
+
+/**
+ * @brief Simulation::stop waits for the thread to finish the tick it is running. The world can be read again afterwards.
+ */
+void Simulation::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running.store(false);
+    }
+    wake.notify_one();
+    if(thread.joinable()) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Simulation::is_running checks if the thread has been started and not stopped.
+ * It stays true after the game is over, until stop() is called.
+ * @return true if the simulation is running, false otherwise
+ */
+bool Simulation::is_running() const {
+    return running.load();
+}
+
+/**
+ * @brief Simulation::push queues an input, stamped with the current time, and wakes the thread to apply it.
+ * Only one thread may push inputs.
+ * @param input is the input
+ * @return true if the input was queued, false if the queue was full
+ */
+bool Simulation::push(World::Input input) {
+    unsigned head = inputHead.load(std::memory_order_relaxed);
+    if(head - inputTail.load(std::memory_order_acquire) == INPUT_QUEUE) {
+        return false;
+    }
+
+    inputs[head % INPUT_QUEUE].input = input;
+    inputs[head % INPUT_QUEUE].time = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        inputHead.store(head + 1, std::memory_order_release);
+    }
+    wake.notify_one();
+    return true;
+}
+
+/**
+ * @brief Simulation::snapshots gets the buffer the snapshots are published to. Only one thread may read it.
+ * @return the buffer
+ */
+SnapshotBuffer& Simulation::snapshots() {
+    return buffer;
+}
+
+/**
+ * @brief Simulation::run is the loop of the thread. It applies the queued inputs, feeds the real time since the
+ * last pass to the game loop, publishes a snapshot if a tick ran or an input was applied and sleeps until the next
+ * tick is due or an input is pushed.
+ * It returns when the game is over or the simulation is stopped.
+ */
+void Simulation::run() {
+    Clock::time_point last = Clock::now();
+
+    while(running.load() && !world->is_over()) {
+        Clock::time_point now = Clock::now();
+        bool applied = apply_inputs(last, now);
+
+        double elapsed = std::chrono::duration<double, std::milli>(now - last).count();
+        last = now;
+
+        if(loop->advance(elapsed) > 0 || applied) {
+            publish();
+        }
+
+        double wait = std::min((1.0 - loop->alpha()) * loop->tick_length() / loop->time_scale(), (double)GameLoop::MAX_FRAME_TIME);
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::microseconds((long long)(wait * 1000)), [this]() {
+            return !running.load() || inputHead.load(std::memory_order_acquire) != inputTail.load(std::memory_order_relaxed);
+        });
+    }
+}
+
+/**
+ * @brief Simulation::apply_inputs applies every queued input to the world in the order they were pushed. Before each
+ * input the game loop is advanced by the real time between the last pass and the moment the input was pushed, and
+ * the world is stepped to within a millisecond of that moment. Inputs that happened after the game ended are not applied.
+ * @param last is the time the game loop was last advanced to. It is moved to the time of the last input applied.
+ * @param now is the time of this pass. Inputs are never applied later than it.
+ * @return true if an input was applied
+ */
+bool Simulation::apply_inputs(Clock::time_point& last, Clock::time_point now) {
+    unsigned tail = inputTail.load(std::memory_order_relaxed);
+    unsigned head = inputHead.load(std::memory_order_acquire);
+    bool applied = tail != head;
+
+    for(; tail != head; ++tail) {
+        const QueuedInput& queued = inputs[tail % INPUT_QUEUE];
+        Clock::time_point at = std::min(std::max(queued.time, last), now);
+
+        loop->advance(std::chrono::duration<double, std::milli>(at - last).count());
+        loop->step_within_tick();
+        last = at;
+        if(world->is_over()) {
+            break;
+        }
+
+        world->apply(queued.input);
+        if(recording != nullptr) {
+            recording->record(world->elapsed(), queued.input);
+        }
+        lastInput = std::chrono::duration_cast<std::chrono::nanoseconds>(queued.time.time_since_epoch()).count();
+    }
+
+    inputTail.store(tail, std::memory_order_release);
+    return applied;
+}
+
+/**
+ * @brief Simulation::publish takes a snapshot of the world into the back of the buffer and publishes it.
+ */
+void Simulation::publish() {
+    buffer.back().capture(*world, viewRows, viewCols, loop->ticks());
+    buffer.back().input_time = lastInput;
+    buffer.publish();
+}
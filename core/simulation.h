@@ -0,0 +1,82 @@
+/** @file simulation.h
+ *  @brief Class declaration for the Simulation class. Runs a GameLoop on a thread of its own.
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "world.h"
+#include "gameloop.h"
+#include "recording.h"
+#include "snapshotbuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief The Simulation class steps a World on a dedicated thread, so a slow frame never holds up a tick.
+ * After every tick that ran, the visible state is published through a SnapshotBuffer, which the drawing thread
+ * reads without locking. Inputs go the other way through a fixed size queue with one writer and one reader.
+ * Every input is stamped with the time it was pushed and wakes the thread, which steps the world up to the
+ * millisecond of game time the input happened at, applies it and publishes a snapshot straight away. Inputs are
+ * recorded with that game time, exactly as a replay applies them.
+ *
+ * The world, the game loop and the recording must not be touched by other threads between start() and stop().
+ */
+class Simulation {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const unsigned INPUT_QUEUE = 64;
+
+    Simulation(World* world, GameLoop* loop);
+    ~Simulation();
+
+    void set_view(int rows, int cols);
+    void set_recording(Recording* recording);
+
+    void start();
+    void stop();
+    bool is_running() const;
+
+    bool push(World::Input input);
+    SnapshotBuffer& snapshots();
+
+private:
+    /**
+     * @brief The QueuedInput struct is an input and the time it was pushed.
+     */
+    struct QueuedInput {
+        World::Input input;
+        Clock::time_point time;
+    };
+
+    void run();
+    bool apply_inputs(Clock::time_point& last, Clock::time_point now);
+    void publish();
+
+    World* world;
+    GameLoop* loop;
+    Recording* recording;
+
+    int viewRows;
+    int viewCols;
+
+    SnapshotBuffer buffer;
+
+    QueuedInput inputs[INPUT_QUEUE];
+    std::atomic<unsigned> inputHead;
+    std::atomic<unsigned> inputTail;
+    long long lastInput;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+
+    std::atomic<bool> running;
+    std::thread thread;
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,103 @@
+/** @file snapshot.cpp
+ *  @brief This file contains the definition of the Snapshot struct.
+ */
+
+#include "snapshot.h"
+
+#include <algorithm>
+
+/**
+ * @brief Snapshot::Snapshot creates an empty snapshot of a game that is over, so nothing but the background is drawn.
+ */
+Snapshot::Snapshot() {
+    tick = 0;
+    elapsed = 0;
+
+    top = 0;
+    left = 0;
+    rows = 0;
+    cols = 0;
+
+    ship_x = 0;
+    ship_y = 0;
+    ship_rotation = 0;
+    over = true;
+
+    attack_moved_at = 0;
+    attack_speed = 1;
+
+    asteroids_moved_at = 0;
+    asteroid_step = 1;
+
+    input_time = 0;
+
+    asteroids_hit = 0;
+    shots_fired = 0;
+}
+
+/**
+ * @brief Snapshot::capture copies the visible state of a world. The storage of the asteroids and the shots is
+ * reused, so taking a snapshot does not allocate once the snapshot has held as many of them before.
+ * The viewport is centered on the ship unless that would show tiles off the gameboard.
+ * @param world is the world to copy
+ * @param view_rows is the number of rows in the viewport
+ * @param view_cols is the number of columns in the viewport
+ * @param tick is the number of ticks the world has run
+ */
+void Snapshot::capture(const World& world, int view_rows, int view_cols, long long tick) {
+    const World::Settings& settings = world.settings();
+
+    this->tick = tick;
+    elapsed = world.elapsed();
+
+    rows = view_rows;
+    cols = view_cols;
+    top = std::max(0, std::min(settings.ship_x - rows / 2, settings.grid_length - rows));
+    left = std::max(0, std::min(settings.ship_y - cols / 2, settings.grid_width - cols));
+
+    ship_x = settings.ship_x;
+    ship_y = settings.ship_y;
+    ship_rotation = world.ship_rotation();
+    over = world.is_over();
+
+    const ProjectilePool& projectiles = world.projectiles();
+    shots.clear();
+    for(size_t i = 0; i < projectiles.size(); ++i) {
+        int x = projectiles.getX(i);
+        int y = projectiles.getY(i);
+        if(x >= top - 1 && x <= top + rows && y >= left - 1 && y <= left + cols) {
+            Body body;
+            body.x = x * AsteroidField::ONE_TILE + AsteroidField::ONE_TILE / 2;
+            body.y = y * AsteroidField::ONE_TILE + AsteroidField::ONE_TILE / 2;
+            body.x_vel = projectiles.getXdir(i) * AsteroidField::ONE_TILE;
+            body.y_vel = projectiles.getYdir(i) * AsteroidField::ONE_TILE;
+            body.level = 0;
+            shots.push_back(body);
+        }
+    }
+    attack_moved_at = world.attack_moved_at();
+    attack_speed = settings.attack_speed;
+
+    const AsteroidField& field = world.asteroids();
+    const OccupancyGrid& grid = field.occupancy();
+
+    asteroids.clear();
+    for(int x = top - 1; x <= top + rows; ++x) {
+        for(int y = left - 1; y <= left + cols; ++y) {
+            for(int i = grid.list_at(x, y); i != -1; i = grid.next_in_list(i)) {
+                Body body;
+                body.x = field.getFixedX(i);
+                body.y = field.getFixedY(i);
+                body.x_vel = field.getXvel(i);
+                body.y_vel = field.getYvel(i);
+                body.level = field.getLevel(i);
+                asteroids.push_back(body);
+            }
+        }
+    }
+    asteroids_moved_at = world.asteroids_moved_at();
+    asteroid_step = settings.asteroid_step;
+
+    asteroids_hit = world.num_asteroids_hit();
+    shots_fired = world.num_shots_fired();
+}
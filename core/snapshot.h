@@ -0,0 +1,70 @@
+/** @file snapshot.h
+ *  @brief Class declaration for the Snapshot struct. A copy of everything needed to draw one frame of a World.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "world.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The Snapshot struct holds the part of a World that is visible in the viewport, taken after a tick.
+ * Once it is handed to the drawing thread it is never written again, so it can be drawn while the world
+ * keeps running. The velocity and the time of the last move of every body are kept so that the drawing
+ * can slide each body from its previous position into its current one.
+ *
+ * Asteroids are taken from the occupancy grid of the viewport, plus one tile around it for the asteroids that
+ * are sliding in or out, so the cost of a snapshot does not depend on the number of asteroids.
+ *
+ * input_time is set by the Simulation to the steady clock time, in nanoseconds, at which the newest input the
+ * snapshot shows was pushed, or 0 if it shows none. It is used to measure how long an input takes to reach the screen.
+ */
+struct Snapshot {
+    /**
+     * @brief The Body struct is a moving object. Its center and the distance it covers each move are in
+     * fixed point, with AsteroidField::ONE_TILE units to a tile. The level of an asteroid is how many times it
+     * broke up; it is 0 for shots.
+     */
+    struct Body {
+        int x;
+        int y;
+        int x_vel;
+        int y_vel;
+        int level;
+    };
+
+    Snapshot();
+
+    void capture(const World& world, int view_rows, int view_cols, long long tick);
+
+    long long tick;
+    long long elapsed;
+
+    int top;
+    int left;
+    int rows;
+    int cols;
+
+    int ship_x;
+    int ship_y;
+    size_t ship_rotation;
+    bool over;
+
+    std::vector<Body> shots;
+    long long attack_moved_at;
+    int attack_speed;
+
+    std::vector<Body> asteroids;
+    long long asteroids_moved_at;
+    int asteroid_step;
+
+    size_t asteroids_hit;
+    size_t shots_fired;
+
+    long long input_time;
+};
+
+#endif // SNAPSHOT_H
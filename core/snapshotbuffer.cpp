@@ -0,0 +1,49 @@
+/** @file snapshotbuffer.cpp
+ *  @brief This file contains the definition of the SnapshotBuffer class.
+ */
+
+#include "snapshotbuffer.h"
+
+/**
+ * @brief SnapshotBuffer::SnapshotBuffer creates three empty snapshots.
+ */
+SnapshotBuffer::SnapshotBuffer() : writing(0), reading(2), ready(1) {
+}
+
+/**
+ * @brief SnapshotBuffer::back gets the snapshot the writer fills next. Only the writing thread may call it.
+ * @return the back snapshot
+ */
+Snapshot& SnapshotBuffer::back() {
+    return buffers[writing];
+}
+
+/**
+ * @brief SnapshotBuffer::publish hands the back snapshot to the reader. The writer gets the snapshot the reader
+ * has not taken yet, or the one the reader has let go of. Only the writing thread may call it.
+ */
+void SnapshotBuffer::publish() {
+    writing = ready.exchange(writing | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+/**
+ * @brief SnapshotBuffer::update makes the newest published snapshot the front snapshot. Only the reading thread may call it.
+ * @return true if a snapshot was published since the last update, false if the front snapshot is still the newest
+ */
+bool SnapshotBuffer::update() {
+    if(!(ready.load(std::memory_order_acquire) & FRESH)) {
+        return false;
+    }
+
+    reading = ready.exchange(reading, std::memory_order_acq_rel) & INDEX;
+    return true;
+}
+
+/**
+ * @brief SnapshotBuffer::front gets the snapshot the reader draws. It does not change until the next update().
+ * Only the reading thread may call it.
+ * @return the front snapshot
+ */
+const Snapshot& SnapshotBuffer::front() const {
+    return buffers[reading];
+}
@@ -0,0 +1,38 @@
+/** @file snapshotbuffer.h
+ *  @brief Class declaration for the SnapshotBuffer class. Hands snapshots from the simulation thread to the drawing thread.
+ */
+
+#ifndef SNAPSHOTBUFFER_H
+#define SNAPSHOTBUFFER_H
+
+#include "snapshot.h"
+
+#include <atomic>
+
+/**
+ * @brief The SnapshotBuffer class passes snapshots from one writing thread to one reading thread without locks.
+ * The reader draws the front snapshot while the writer fills the back one. A third snapshot sits between them:
+ * publishing swaps it with the back snapshot and update() swaps it with the front one, so neither thread ever
+ * waits for the other and the reader always gets the newest snapshot. No snapshot is copied.
+ */
+class SnapshotBuffer {
+public:
+    SnapshotBuffer();
+
+    Snapshot& back();
+    void publish();
+
+    bool update();
+    const Snapshot& front() const;
+
+private:
+    static const int INDEX = 3;
+    static const int FRESH = 4;
+
+    Snapshot buffers[3];
+    int writing;
+    int reading;
+    std::atomic<int> ready;
+};
+
+#endif // SNAPSHOTBUFFER_H
@@ -0,0 +1,136 @@
+/** @file workstealingpool.cpp
+ *  @brief This file contains the definition of the WorkStealingPool class.
+ */
+
+#include "workstealingpool.h"
+
+/**
+ * @brief WorkStealingPool::WorkStealingPool starts the worker threads, which wait for a batch.
+ * @param threads is the number of workers, or 0 for one per core
+ */
+WorkStealingPool::WorkStealingPool(unsigned threads) : body(nullptr), batch(0), busy(0), stopping(false) {
+    if(threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if(threads == 0) {
+        threads = 1;
+    }
+
+    for(unsigned i = 0; i < threads; ++i) {
+        queues.push_back(std::unique_ptr<Queue>(new Queue));
+    }
+    for(unsigned i = 0; i < threads; ++i) {
+        this->threads.push_back(std::thread(&WorkStealingPool::work, this, i));
+    }
+}
+
+/**
+ * @brief WorkStealingPool::~WorkStealingPool stops the worker threads.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    started.notify_all();
+
+    for(size_t i = 0; i < threads.size(); ++i) {
+        threads[i].join();
+    }
+}
+
+/**
+ * @brief WorkStealingPool::size gets the number of workers
+ * @return the number of workers
+ */
+unsigned WorkStealingPool::size() const {
+    return (unsigned)threads.size();
+}
+
+/**
+ * @brief WorkStealingPool::run runs a batch of tasks on the workers and returns once every task has finished.
+ * Only one batch runs at a time.
+ * @param tasks is the number of tasks
+ * @param task runs one task
+ */
+void WorkStealingPool::run(size_t tasks, const Task& task) {
+    size_t workers = queues.size();
+    for(size_t w = 0; w < workers; ++w) {
+        std::lock_guard<std::mutex> guard(queues[w]->lock);
+        for(size_t t = tasks * w / workers; t < tasks * (w + 1) / workers; ++t) {
+            queues[w]->tasks.push_back(t);
+        }
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+    body = &task;
+    busy = (unsigned)workers;
+    ++batch;
+    started.notify_all();
+
+    finished.wait(guard, [this]() { return busy == 0; });
+    body = nullptr;
+}
+
+/**
+ * @brief WorkStealingPool::work is the loop of a worker thread. It waits for a batch, runs tasks until no queue
+ * has any left and reports that it is done.
+ * @param worker is the number of the worker
+ */
+void WorkStealingPool::work(unsigned worker) {
+    unsigned long long done = 0;
+
+    for(;;) {
+        const Task* task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            started.wait(guard, [&]() { return stopping || batch != done; });
+            if(stopping) {
+                return;
+            }
+            done = batch;
+            task = body;
+        }
+
+        size_t next;
+        while(take(worker, next)) {
+            (*task)(next, worker);
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+        if(--busy == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+/**
+ * @brief WorkStealingPool::take gets the next task for a worker: the last task of its own queue or, if that is
+ * empty, the first task of the next queue that has one.
+ * @param worker is the number of the worker
+ * @param task is set to the task
+ * @return true if a task was found, false if every queue is empty
+ */
+bool WorkStealingPool::take(unsigned worker, size_t& task) {
+    {
+        Queue& own = *queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if(!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for(size_t i = 1; i < queues.size(); ++i) {
+        Queue& victim = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,62 @@
+/** @file workstealingpool.h
+ *  @brief Class declaration for the WorkStealingPool class. Runs batches of independent tasks on every core.
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The WorkStealingPool class keeps one thread per core and a queue of tasks for each of them.
+ * A batch of tasks is split evenly over the queues. Each worker takes tasks from the back of its own queue
+ * and, once it is empty, steals from the front of the queues of the other workers, so the workers stay busy
+ * when some tasks take much longer than others. A task is a number in [0, tasks) and is run exactly once.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Task runs one task of a batch. It is given the number of the task and the number of the worker
+     * running it, which is below size(), so each worker can keep state of its own.
+     */
+    typedef std::function<void(size_t task, unsigned worker)> Task;
+
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+
+    unsigned size() const;
+    void run(size_t tasks, const Task& task);
+
+private:
+    /**
+     * @brief The Queue struct holds the tasks of one worker.
+     */
+    struct Queue {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    void work(unsigned worker);
+    bool take(unsigned worker, size_t& task);
+
+    std::vector<std::unique_ptr<Queue> > queues;
+    std::vector<std::thread> threads;
+
+    std::mutex lock;
+    std::condition_variable started;
+    std::condition_variable finished;
+
+    const Task* body;
+    unsigned long long batch;
+    unsigned busy;
+    bool stopping;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,805 @@
+/** @file world.cpp
+ *  @brief This file contains the definition of the World class.
+ */
+
+#include "world.h"
+#include "boardgeometry.h"
+
+#include <algorithm>
+#include <cstring>
+
+const int NORTH = 0;
+const int NORTHEAST = 45;
+const int EAST = 90;
+const int SOUTHEAST = 135;
+const int SOUTH = 180;
+const int SOUTHWEST = 225;
+const int WEST = 270;
+const int NORTHWEST = 315;
+
+static const char STATE_MAGIC[4] = { 'A', 'W', 'L', 'D' };
+static const uint32_t STATE_VERSION = 2;
+
+/**
+ * @brief The StateHeader struct is the start of a block written by World::save_state(). The asteroids and the
+ * shots follow it.
+ */
+struct StateHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t size;
+    uint64_t num_asteroids;
+    uint64_t num_shots;
+
+    int32_t grid_width;
+    int32_t grid_length;
+    int32_t num_asteroids_setting;
+    int32_t asteroid_speed;
+    int32_t asteroid_step;
+    int32_t asteroid_speed_spread;
+    int32_t rate_of_num_astr_increase;
+    int32_t asteroid_fragments;
+    int32_t asteroid_collisions;
+    int32_t ship_x;
+    int32_t ship_y;
+    int32_t attack_speed;
+    int32_t max_projectiles;
+    int32_t over;
+    uint64_t seed;
+
+    uint64_t rng;
+    uint64_t ship_rotation;
+    uint64_t asteroids_hit;
+    uint64_t shots_fired;
+
+    int64_t clock;
+    int64_t next_attack;
+    int64_t next_asteroid_move;
+    int64_t next_asteroid_increase;
+};
+
+static_assert(sizeof(StateHeader) == 160, "the state header has no padding");
+
+/**
+ * @brief World::Settings::Settings sets the default tuning values of the game.
+ */
+World::Settings::Settings() {
+    grid_width = 23;
+    grid_length = 23;
+
+    num_asteroids = 3;
+    asteroid_speed = 600;
+    asteroid_step = 10;
+    asteroid_speed_spread = 25;
+    rate_of_num_astr_increase = 30*1000;
+    asteroid_fragments = 2;
+    asteroid_collisions = true;
+
+    ship_x = 11;
+    ship_y = 11;
+    attack_speed = 50;
+    max_projectiles = 8;
+
+    seed = 0;
+}
+
+/**
+ * @brief World::World constructs a world and starts a new game with the given settings.
+ * @param settings are the tuning values of the game
+ */
+World::World(const Settings& settings) : profiler(nullptr) {
+    set_settings(settings);
+    reset();
+}
+
+/**
+ * @brief World::settings gets the tuning values of the game
+ * @return the settings
+ */
+const World::Settings& World::settings() const {
+    return config;
+}
+
+/**
+ * @brief World::set_settings changes the tuning values of the game. The new values
+ * take effect the next time reset() is called. The size of the gameboard is clamped to
+ * [1, Settings::MAX_GRID_SIZE], the ship is kept on the gameboard, the asteroids and the shots move at least every
+ * millisecond, the number of asteroids increases at most every millisecond, at least one shot can be in flight and
+ * an asteroid breaks into at most AsteroidField::MAX_FRAGMENTS fragments. A period of zero would keep step() from
+ * ever catching up with the clock.
+ * @param settings are the new tuning values
+ */
+void World::set_settings(const Settings& settings) {
+    config = settings;
+
+    config.grid_width = std::max(1, std::min(config.grid_width, (int)Settings::MAX_GRID_SIZE));
+    config.grid_length = std::max(1, std::min(config.grid_length, (int)Settings::MAX_GRID_SIZE));
+    config.ship_x = std::max(0, std::min(config.ship_x, config.grid_length - 1));
+    config.ship_y = std::max(0, std::min(config.ship_y, config.grid_width - 1));
+    config.asteroid_step = std::max(1, config.asteroid_step);
+    config.attack_speed = std::max(1, config.attack_speed);
+    config.rate_of_num_astr_increase = std::max(1, config.rate_of_num_astr_increase);
+    config.max_projectiles = std::max(1, config.max_projectiles);
+    config.asteroid_fragments = std::max(0, std::min(config.asteroid_fragments, (int)AsteroidField::MAX_FRAGMENTS));
+}
+
+/**
+ * @brief World::reset starts a new game. The random number generator is seeded again, the asteroids are
+ * respawned, every shot is removed, the ship faces north and the counters are set back to zero.
+ * The storage of the previous game is reused.
+ */
+void World::reset() {
+    rng.seed(config.seed);
+
+    astField.clear();
+    astField.set_board(config.grid_length, config.grid_width);
+    astField.set_speed(config.asteroid_speed, config.asteroid_step, config.asteroid_speed_spread);
+    astField.spawn_wave(std::max(0, config.num_asteroids), rng);
+    spent.clear();
+
+    over = false;
+    shipCurrentRotation = 0;
+
+    shots.set_capacity(config.max_projectiles);
+
+    asteroids_hit = 0;
+    shots_fired = 0;
+
+    clock = 0;
+    next_attack = config.attack_speed;
+    next_asteroid_move = config.asteroid_step;
+    next_asteroid_increase = config.rate_of_num_astr_increase;
+}
+
+/**
+ * @brief World::step advances the game by dt milliseconds. Each subsystem fires once for every
+ * period that elapses. When the shots and the asteroids are due at the same time they move together, and the
+ * hits of that move are found once both have moved. The number of asteroids increases after any move due at
+ * the same time. Nothing happens once the game is over.
+ * Each subsystem, the search for hits and the whole step are timed when a profiler is set.
+ * @param dt is the number of milliseconds to advance the game by
+ */
+void World::step(int dt) {
+    if(over) {
+        return;
+    }
+
+    ScopedTimer tick(profiler, Profiler::TICK);
+    clock += dt;
+
+    while(!over) {
+        long long next = next_attack;
+        if(next_asteroid_move < next)
+            next = next_asteroid_move;
+        if(next_asteroid_increase < next)
+            next = next_asteroid_increase;
+
+        if(next > clock) {
+            break;
+        }
+
+        bool attack_due = next == next_attack;
+        bool asteroids_due = next == next_asteroid_move;
+
+        if(attack_due) {
+            ScopedTimer timer(profiler, Profiler::MOVE_ATTACK);
+            advance_attack();
+            next_attack += config.attack_speed;
+        }
+        if(asteroids_due) {
+            ScopedTimer timer(profiler, Profiler::MOVE_ASTEROIDS);
+            advance_asteroids();
+            next_asteroid_move += config.asteroid_step;
+        }
+
+        if(attack_due || asteroids_due) {
+            if(!over) {
+                ScopedTimer timer(profiler, Profiler::RESOLVE_HITS);
+                resolve_hits(attack_due, asteroids_due);
+            }
+        } else {
+            ScopedTimer timer(profiler, Profiler::INCREASE_ASTEROIDS);
+            increase_num_asteroids();
+            next_asteroid_increase += config.rate_of_num_astr_increase;
+        }
+    }
+
+    if(profiler != nullptr) {
+        profiler->set_entities(astField.size());
+    }
+}
+
+/**
+ * @brief World::set_profiler makes step() record how long each subsystem takes
+ * @param profiler is the profiler to record into, or null to stop recording
+ */
+void World::set_profiler(Profiler* profiler) {
+    this->profiler = profiler;
+}
+
+/**
+ * @brief World::move_asteroids moves every asteroid by one step while the shots stay where they are, and
+ * finds the shots the asteroids ran into.
+ */
+void World::move_asteroids() {
+    advance_asteroids();
+    if(!over) {
+        resolve_hits(false, true);
+    }
+}
+
+/**
+ * @brief World::move_attack moves every shot by one tile while the asteroids stay where they are, and
+ * finds the asteroids the shots ran into.
+ */
+void World::move_attack() {
+    advance_attack();
+    resolve_hits(true, false);
+}
+
+/**
+ * @brief World::advance_asteroids moves every asteroid by one step, after the asteroids that touch bounced off each
+ * other if collisions are on. The game is over if an asteroid reaches the ship. Otherwise the whole asteroids that
+ * left the gameboard are respawned, and the fragments that left it are removed once the hits of the move are found.
+ */
+void World::advance_asteroids() {
+    if(config.asteroid_collisions) {
+        ScopedTimer timer(profiler, Profiler::COLLIDE_ASTEROIDS);
+        astField.collide();
+    }
+
+    AsteroidField::Bounds bounds;
+    bounds.max_x = config.grid_length - 1;
+    bounds.max_y = config.grid_width - 1;
+    bounds.ship_x = config.ship_x;
+    bounds.ship_y = config.ship_y;
+
+    if(astField.move(bounds, respawnMask)) {
+        over = true;
+        return;
+    }
+
+    for(size_t byte = 0; byte < respawnMask.size(); ++byte) {
+        unsigned bits = respawnMask[byte];
+        while(bits != 0) {
+            int bit = 0;
+            while(!(bits & (1u << bit))) {
+                ++bit;
+            }
+            size_t i = byte * 8 + bit;
+            if(astField.getLevel(i) == 0) {
+                astField.respawn(i, rng);
+            } else {
+                spent.push_back(i);
+            }
+            bits &= bits - 1;
+        }
+    }
+}
+
+/**
+ * @brief World::advance_attack removes the shots that reached the border of the gameboard and moves every
+ * other shot by one tile.
+ */
+void World::advance_attack() {
+    size_t i = 0;
+    while(i < shots.size()) {
+        if(is_attack_in_valid_range(i)) {
+            ++i;
+        } else {
+            shots.remove(i);
+        }
+    }
+
+    shots.move();
+}
+
+/**
+ * @brief World::resolve_hits finds the shots that hit an asteroid during the last move, with the search specialized
+ * for the size of the gameboard when it is one of the FixedBoard layouts. The fragments that were destroyed or
+ * left the gameboard are removed afterwards, so the indices stay put while the hits are found.
+ * @param attack_moved is true if the shots moved
+ * @param asteroids_moved is true if the asteroids moved
+ */
+void World::resolve_hits(bool attack_moved, bool asteroids_moved) {
+    with_board(config.grid_length, config.grid_width, [&](const auto& board) {
+        this->resolve_hits_on(board, attack_moved, asteroids_moved);
+    });
+    remove_spent();
+}
+
+/**
+ * @brief World::resolve_hits_on finds the shots that hit an asteroid during the last move. Each shot and asteroid
+ * that moved slides from its old tile to its new one, and a shot hits the first asteroid it meets on the way.
+ * The asteroid breaks up and is counted as hit, and the shot is removed. Fragments that broke off during this
+ * search did not slide and are left alone.
+ * Only the asteroids within two tiles of a shot can meet it, and they are found through the occupancy grid.
+ * When the five by five tiles around a shot are all on the gameboard, which is the case for all but the shots
+ * at the edges, each row of five tiles is read from the bitboard at once and only the occupied tiles are visited.
+ * Asteroids that were respawned by this move did not slide, and are left alone until they move again.
+ * @param board is the size of the gameboard
+ * @param attack_moved is true if the shots moved
+ * @param asteroids_moved is true if the asteroids moved
+ */
+template<class Board>
+void World::resolve_hits_on(const Board& board, bool attack_moved, bool asteroids_moved) {
+    const OccupancyGrid& grid = astField.occupancy();
+    const size_t settled = astField.size();
+    struck.clear();
+
+    size_t i = 0;
+    while(i < shots.size()) {
+        int shot_x = shots.getX(i);
+        int shot_y = shots.getY(i);
+        int shot_x0 = attack_moved ? shot_x - shots.getXdir(i) : shot_x;
+        int shot_y0 = attack_moved ? shot_y - shots.getYdir(i) : shot_y;
+
+        int hit = -1;
+        int hit_num = 0;
+        int hit_den = 1;
+
+        bool window = board.on_board(shot_x - 2, shot_y - 2) && board.on_board(shot_x + 2, shot_y + 2);
+
+        for(int x = shot_x - 2; x <= shot_x + 2; ++x) {
+            unsigned row = 0x1f;
+            if(window) {
+                row = grid.occupied_run(board.cell(x, shot_y - 2), 5);
+            }
+
+            for(int y = shot_y - 2; row != 0; ++y, row >>= 1) {
+                if(!(row & 1) || (!window && !board.on_board(x, y))) {
+                    continue;
+                }
+
+                for(int j = grid.list_at_cell(board.cell(x, y)); j != -1; j = grid.next_in_list(j)) {
+                    if((size_t)j >= settled) {
+                        continue;
+                    }
+                    if(asteroids_moved && (respawnMask[j >> 3] >> (j & 7)) & 1) {
+                        continue;
+                    }
+                    if(std::find(struck.begin(), struck.end(), (size_t)j) != struck.end()) {
+                        continue;
+                    }
+
+                    int x0 = x;
+                    int y0 = y;
+                    if(asteroids_moved) {
+                        x0 = (astField.getFixedX(j) - astField.getXvel(j)) >> AsteroidField::FRACTION_BITS;
+                        y0 = (astField.getFixedY(j) - astField.getYvel(j)) >> AsteroidField::FRACTION_BITS;
+                    }
+
+                    int num;
+                    int den;
+                    if(!sweep(shot_x0 - x0, shot_y0 - y0, shot_x - x, shot_y - y, num, den)) {
+                        continue;
+                    }
+
+                    long long earlier = (long long)num * hit_den - (long long)hit_num * den;
+                    if(hit == -1 || earlier < 0 || (earlier == 0 && j < hit)) {
+                        hit = j;
+                        hit_num = num;
+                        hit_den = den;
+                    }
+                }
+            }
+        }
+
+        if(hit == -1) {
+            ++i;
+            continue;
+        }
+
+        shots.remove(i);
+        break_up(hit);
+        struck.push_back(hit);
+        asteroids_hit++;
+    }
+}
+
+/**
+ * @brief World::break_up breaks an asteroid that was hit into fragments, unless it is one of the smallest
+ * fragments. A whole asteroid then respawns and a fragment is removed with the other spent fragments.
+ * Without fragments, every asteroid that is hit respawns.
+ * @param i is the index of the asteroid
+ */
+void World::break_up(size_t i) {
+    int level = astField.getLevel(i);
+    if(config.asteroid_fragments > 0 && level < AsteroidField::MAX_LEVEL) {
+        astField.spawn_fragments(i, config.asteroid_fragments, rng);
+    }
+
+    if(level == 0) {
+        astField.respawn(i, rng);
+    } else {
+        spent.push_back(i);
+    }
+}
+
+/**
+ * @brief World::remove_spent removes the fragments that were destroyed or left the gameboard, from the highest
+ * index down.
+ */
+void World::remove_spent() {
+    std::sort(spent.begin(), spent.end());
+    spent.erase(std::unique(spent.begin(), spent.end()), spent.end());
+    for(size_t k = spent.size(); k-- > 0; ) {
+        astField.remove(spent[k]);
+    }
+    spent.clear();
+}
+
+/**
+ * @brief World::sweep finds when two bodies that slide in straight lines are at the same point. The bodies
+ * are given by their offset from each other before and after the move.
+ * @param d0x is the difference of the rows before the move
+ * @param d0y is the difference of the columns before the move
+ * @param d1x is the difference of the rows after the move
+ * @param d1y is the difference of the columns after the move
+ * @param num is set to the numerator of the moment they meet, as a fraction of the move
+ * @param den is set to the denominator of the moment they meet, which is positive
+ * @return true if the bodies meet during the move, false otherwise
+ */
+bool World::sweep(int d0x, int d0y, int d1x, int d1y, int& num, int& den) {
+    int ddx = d1x - d0x;
+    int ddy = d1y - d0y;
+
+    // a difference that does not change has to be zero all along
+    if((ddx == 0 && d0x != 0) || (ddy == 0 && d0y != 0)) {
+        return false;
+    }
+
+    if(ddx == 0 && ddy == 0) {
+        num = 0;
+        den = 1;
+        return true;
+    }
+
+    num = ddx != 0 ? -d0x : -d0y;
+    den = ddx != 0 ? ddx : ddy;
+    if(den < 0) {
+        num = -num;
+        den = -den;
+    }
+
+    if(num < 0 || num > den) {
+        return false;
+    }
+
+    // both differences have to reach zero at the same moment
+    return ddx == 0 || ddy == 0 || (long long)d0x * ddy == (long long)d0y * ddx;
+}
+
+/**
+ * @brief World::increase_num_asteroids adds one asteroid to the game.
+ */
+void World::increase_num_asteroids() {
+    astField.spawn(rng);
+}
+
+/**
+ * @brief World::spawn_wave adds n asteroids to the game at once, drawn from the same random numbers as n calls to
+ * increase_num_asteroids() would draw. Used for the first asteroids of a game and for stress scenarios.
+ * @param n is the number of asteroids
+ */
+void World::spawn_wave(size_t n) {
+    astField.spawn_wave(n, rng);
+}
+
+/**
+ * @brief World::apply carries out an action of the player
+ * @param input is the action
+ */
+void World::apply(Input input) {
+    switch(input) {
+    case(ROTATE_LEFT):
+        rotate_left();
+        break;
+    case(ROTATE_RIGHT):
+        rotate_right();
+        break;
+    case(FIRE):
+        fire();
+        break;
+    }
+}
+
+/**
+ * @brief World::rotate_left turns the ship 45 degrees to its left.
+ */
+void World::rotate_left() {
+    shipCurrentRotation += 315;
+}
+
+/**
+ * @brief World::rotate_right turns the ship 45 degrees to its right.
+ */
+void World::rotate_right() {
+    shipCurrentRotation += 45;
+}
+
+/**
+ * @brief World::fire launches a shot from the ship in the direction the ship is facing.
+ * Nothing happens if Settings::max_projectiles shots are already in flight.
+ */
+void World::fire() {
+
+    if (shots.full()) {
+        return;
+    }
+
+    shots_fired++;
+
+    int attackXDirection = 0;
+    int attackYDirection = 0;
+
+    switch(shipCurrentRotation % 360) {
+    case(NORTH):
+        attackXDirection = -1;
+        attackYDirection = 0;
+        break;
+    case(NORTHEAST):
+        attackXDirection = -1;
+        attackYDirection = 1;
+        break;
+    case(EAST):
+        attackXDirection = 0;
+        attackYDirection = 1;
+        break;
+    case(SOUTHEAST):
+        attackXDirection = 1;
+        attackYDirection = 1;
+        break;
+    case(SOUTH):
+        attackXDirection = 1;
+        attackYDirection = 0;
+        break;
+    case(SOUTHWEST):
+        attackXDirection = 1;
+        attackYDirection = -1;
+        break;
+    case(WEST):
+        attackXDirection = 0;
+        attackYDirection = -1;
+        break;
+    case(NORTHWEST):
+        attackXDirection = -1;
+        attackYDirection = -1;
+        break;
+    default:
+        break;
+    }
+
+    shots.fire(config.ship_x, config.ship_y, attackXDirection, attackYDirection);
+}
+
+/**
+ * @brief World::is_over checks if an asteroid has reached the ship
+ * @return true if the game is over, false otherwise
+ */
+bool World::is_over() const {
+    return over;
+}
+
+/**
+ * @brief World::elapsed gets the time that has passed since the game started
+ * @return the game time in milliseconds
+ */
+long long World::elapsed() const {
+    return clock;
+}
+
+/**
+ * @brief World::asteroids gets the asteroids in the game
+ * @return a reference to the asteroids
+ */
+const AsteroidField& World::asteroids() const {
+    return astField;
+}
+
+/**
+ * @brief World::projectiles gets the shots in flight
+ * @return a reference to the shots
+ */
+const ProjectilePool& World::projectiles() const {
+    return shots;
+}
+
+/**
+ * @brief World::collided_with_attack checks if a shot is on the tile of an asteroid.
+ * @param i is the index of the asteroid that we are checking against for a collision.
+ * @return true if a collision occured, false otherwise
+ */
+bool World::collided_with_attack(size_t i) const {
+    for(size_t j = 0; j < shots.size(); ++j) {
+        if(astField.getX(i) == shots.getX(j) && astField.getY(i) == shots.getY(j)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief World::ship_rotation gets the rotation of the ship
+ * @return the rotation of the ship in degrees, clockwise from north
+ */
+size_t World::ship_rotation() const {
+    return shipCurrentRotation % 360;
+}
+
+/**
+ * @brief World::ship_diagonal checks if the ship is facing NE, SE, SW or NW
+ * @return true if the ship is not facing a cardinal direction, false otherwise
+ */
+bool World::ship_diagonal() const {
+    return shipCurrentRotation % 90 != 0;
+}
+
+/**
+ * @brief World::asteroids_moved_at gets the game time at which the asteroids last moved
+ * @return the game time in milliseconds, 0 before the first move
+ */
+long long World::asteroids_moved_at() const {
+    return next_asteroid_move - config.asteroid_step;
+}
+
+/**
+ * @brief World::attack_moved_at gets the game time at which the shots last moved
+ * @return the game time in milliseconds, 0 before the first move
+ */
+long long World::attack_moved_at() const {
+    return next_attack - config.attack_speed;
+}
+
+/**
+ * @brief World::num_asteroids_hit gets the number of asteroids destroyed in this game
+ * @return the number of asteroids hit
+ */
+size_t World::num_asteroids_hit() const {
+    return asteroids_hit;
+}
+
+/**
+ * @brief World::num_shots_fired gets the number of attacks launched in this game
+ * @return the number of shots fired
+ */
+size_t World::num_shots_fired() const {
+    return shots_fired;
+}
+
+/**
+ * @brief World::is_attack_in_valid_range
+ * This function checks that there is at least one grid between a shot
+ * and the border of the grid.
+ * @param i is the index of the shot
+ * @return true is there is at least one grid, false otherwise.
+ */
+bool World::is_attack_in_valid_range(size_t i) const {
+    int x = shots.getX(i);
+    int y = shots.getY(i);
+    return x > 0 && x < config.grid_length - 1 && y > 0 && y < config.grid_width - 1;
+}
+
+/**
+ * @brief World::state_size gets the number of bytes save_state() writes
+ * @return the size of the header plus the size of the asteroids and of the shots in flight
+ */
+size_t World::state_size() const {
+    return sizeof(StateHeader) + astField.state_size() + shots.state_size();
+}
+
+/**
+ * @brief World::save_state copies the whole game. The block is resized to state_size(), so saving every frame into
+ * the same block only allocates when the game has more asteroids than ever before.
+ * @param out receives the state of the game
+ */
+void World::save_state(std::vector<unsigned char>& out) const {
+    out.resize(state_size());
+
+    StateHeader h;
+    std::memcpy(h.magic, STATE_MAGIC, sizeof(STATE_MAGIC));
+    h.version = STATE_VERSION;
+    h.size = out.size();
+    h.num_asteroids = astField.size();
+    h.num_shots = shots.size();
+
+    h.grid_width = config.grid_width;
+    h.grid_length = config.grid_length;
+    h.num_asteroids_setting = config.num_asteroids;
+    h.asteroid_speed = config.asteroid_speed;
+    h.asteroid_step = config.asteroid_step;
+    h.asteroid_speed_spread = config.asteroid_speed_spread;
+    h.rate_of_num_astr_increase = config.rate_of_num_astr_increase;
+    h.asteroid_fragments = config.asteroid_fragments;
+    h.asteroid_collisions = config.asteroid_collisions;
+    h.ship_x = config.ship_x;
+    h.ship_y = config.ship_y;
+    h.attack_speed = config.attack_speed;
+    h.max_projectiles = config.max_projectiles;
+    h.over = over;
+    h.seed = config.seed;
+
+    h.rng = rng.state();
+    h.ship_rotation = shipCurrentRotation;
+    h.asteroids_hit = asteroids_hit;
+    h.shots_fired = shots_fired;
+
+    h.clock = clock;
+    h.next_attack = next_attack;
+    h.next_asteroid_move = next_asteroid_move;
+    h.next_asteroid_increase = next_asteroid_increase;
+
+    std::memcpy(out.data(), &h, sizeof(h));
+    astField.save_state(out.data() + sizeof(h));
+    shots.save_state(out.data() + sizeof(h) + astField.state_size());
+}
+
+/**
+ * @brief World::restore_state puts back a game saved by save_state(), settings included. The profiler is kept.
+ * Nothing is allocated when the gameboard has the same size as before and the world held as many asteroids before.
+ * @param state is a block written by save_state()
+ * @return false if the block is not the state of a world, or holds something no game can reach: a gameboard of a
+ * size set_settings() does not allow, a period that is not positive, a generator state of zero, or an asteroid that
+ * AsteroidField::valid_state() rejects. Only the asteroids that left on the move that ended a game may be a tile past
+ * the edge of the gameboard. The world is then left as it was
+ */
+bool World::restore_state(const std::vector<unsigned char>& state) {
+    StateHeader h;
+    if(state.size() < sizeof(h)) {
+        return false;
+    }
+    std::memcpy(&h, state.data(), sizeof(h));
+
+    const uint64_t asteroid = 4 * sizeof(int) + 1;
+    const uint64_t shot = 4 * sizeof(int);
+    if(std::memcmp(h.magic, STATE_MAGIC, sizeof(STATE_MAGIC)) != 0 || h.version != STATE_VERSION
+            || h.size != state.size() || h.num_asteroids > state.size() / asteroid || h.num_shots > state.size() / shot
+            || h.size != sizeof(h) + h.num_asteroids * asteroid + h.num_shots * shot
+            || h.num_shots > (uint64_t)std::max(1, h.max_projectiles)
+            || h.asteroid_step <= 0 || h.attack_speed <= 0 || h.rate_of_num_astr_increase <= 0 || h.rng == 0
+            || h.grid_width < 1 || h.grid_width > Settings::MAX_GRID_SIZE
+            || h.grid_length < 1 || h.grid_length > Settings::MAX_GRID_SIZE
+            || !AsteroidField::valid_state(state.data() + sizeof(h), h.num_asteroids, h.grid_length, h.grid_width,
+                                           h.over != 0 ? 1 : 0)) {
+        return false;
+    }
+
+    Settings settings;
+    settings.grid_width = h.grid_width;
+    settings.grid_length = h.grid_length;
+    settings.num_asteroids = h.num_asteroids_setting;
+    settings.asteroid_speed = h.asteroid_speed;
+    settings.asteroid_step = h.asteroid_step;
+    settings.asteroid_speed_spread = h.asteroid_speed_spread;
+    settings.rate_of_num_astr_increase = h.rate_of_num_astr_increase;
+    settings.asteroid_fragments = h.asteroid_fragments;
+    settings.asteroid_collisions = h.asteroid_collisions != 0;
+    settings.ship_x = h.ship_x;
+    settings.ship_y = h.ship_y;
+    settings.attack_speed = h.attack_speed;
+    settings.max_projectiles = h.max_projectiles;
+    settings.seed = h.seed;
+    set_settings(settings);
+
+    rng.set_state(h.rng);
+
+    astField.clear();
+    astField.set_board(config.grid_length, config.grid_width);
+    astField.set_speed(config.asteroid_speed, config.asteroid_step, config.asteroid_speed_spread);
+    astField.restore_state(state.data() + sizeof(h), h.num_asteroids);
+    spent.clear();
+
+    shots.set_capacity(config.max_projectiles);
+    shots.restore_state(state.data() + sizeof(h) + h.num_asteroids * asteroid, h.num_shots);
+
+    over = h.over != 0;
+    shipCurrentRotation = h.ship_rotation;
+    asteroids_hit = h.asteroids_hit;
+    shots_fired = h.shots_fired;
+
+    clock = h.clock;
+    next_attack = h.next_attack;
+    next_asteroid_move = h.next_asteroid_move;
+    next_asteroid_increase = h.next_asteroid_increase;
+    return true;
+}
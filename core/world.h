@@ -0,0 +1,159 @@
+/** @file world.h
+ *  @brief Class declaration for the World class. The World owns the complete state of a game
+ *         (asteroids, attack, ship orientation and the score counters) and has no dependency on Qt,
+ *         so it can be drawn by the MainWindow or run headless.
+ */
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "asteroidfield.h"
+#include "projectilepool.h"
+#include "rng.h"
+#include "profiler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The World class advances a game of Asteroids. Every subsystem runs at its own period, given in
+ * milliseconds, and step() fires each of them as many times as the elapsed time calls for.
+ * The gameboard can be up to Settings::MAX_GRID_SIZE tiles on each side.
+ * All randomness comes from a generator seeded by Settings::seed, so the same seed and the same inputs at
+ * the same times always play out the same game.
+ *
+ * Asteroids move a fraction of a tile every Settings::asteroid_step milliseconds and take Settings::asteroid_speed
+ * milliseconds per tile on average; each one is up to Settings::asteroid_speed_spread percent faster or slower.
+ *
+ * Up to Settings::max_projectiles shots can be in flight. Hits are found by sweeping: every shot and asteroid
+ * that moved at the same game time is taken to slide along the segment from its old tile to its new one, and
+ * a shot hits an asteroid when both are at the same point at the same moment. A shot and an asteroid that swap
+ * tiles or cross diagonally are therefore hit, however the moves line up with the ticks. Each shot hits at most
+ * one asteroid and each asteroid is hit by at most one shot per move.
+ *
+ * A whole asteroid that is hit breaks into Settings::asteroid_fragments fragments and respawns, so the number of
+ * whole asteroids only grows over time as before. A fragment that is hit breaks into smaller fragments until they
+ * reach AsteroidField::MAX_LEVEL, and the smallest fragments are destroyed; fragments that leave the gameboard are
+ * gone too. With Settings::asteroid_collisions, asteroids that touch bounce off each other before every move.
+ *
+ * save_state() copies the whole game into a flat block of bytes: a header of fixed size with the settings, the
+ * state of the generator, the clocks and the counters, then the asteroids and the shots as plain arrays.
+ * restore_state() puts the game back exactly as it was, so it plays on the same from there. A block is only meant
+ * to be read on the kind of machine that wrote it.
+ */
+class World {
+public:
+    /**
+     * @brief The Input enum lists the actions of the player.
+     */
+    enum Input {
+        ROTATE_LEFT = 0,
+        ROTATE_RIGHT = 1,
+        FIRE = 2
+    };
+
+    /**
+     * @brief The Settings struct holds the tuning values of a game.
+     */
+    struct Settings {
+        Settings();
+
+        static const int MAX_GRID_SIZE = 4096;
+
+        int grid_width;
+        int grid_length;
+
+        int num_asteroids;
+        int asteroid_speed;
+        int asteroid_step;
+        int asteroid_speed_spread;
+        int rate_of_num_astr_increase;
+        int asteroid_fragments;
+        bool asteroid_collisions;
+
+        int ship_x;
+        int ship_y;
+        int attack_speed;
+        int max_projectiles;
+
+        uint64_t seed;
+    };
+
+    explicit World(const Settings& settings = Settings());
+
+    const Settings& settings() const;
+    void set_settings(const Settings& settings);
+
+    void reset();
+    void step(int dt);
+
+    void set_profiler(Profiler* profiler);
+
+    void move_asteroids();
+    void move_attack();
+    void increase_num_asteroids();
+    void spawn_wave(size_t n);
+
+    void apply(Input input);
+    void rotate_left();
+    void rotate_right();
+    void fire();
+
+    bool is_over() const;
+    long long elapsed() const;
+
+    const AsteroidField& asteroids() const;
+    const ProjectilePool& projectiles() const;
+    bool collided_with_attack(size_t i) const;
+
+    size_t ship_rotation() const;
+    bool ship_diagonal() const;
+
+    long long asteroids_moved_at() const;
+    long long attack_moved_at() const;
+
+    size_t num_asteroids_hit() const;
+    size_t num_shots_fired() const;
+
+    size_t state_size() const;
+    void save_state(std::vector<unsigned char>& out) const;
+    bool restore_state(const std::vector<unsigned char>& state);
+
+private:
+    bool is_attack_in_valid_range(size_t i) const;
+    void advance_attack();
+    void advance_asteroids();
+    void resolve_hits(bool attack_moved, bool asteroids_moved);
+    template<class Board>
+    void resolve_hits_on(const Board& board, bool attack_moved, bool asteroids_moved);
+
+    void break_up(size_t i);
+    void remove_spent();
+
+    static bool sweep(int d0x, int d0y, int d1x, int d1y, int& num, int& den);
+
+    Settings config;
+    Rng rng;
+    Profiler* profiler;
+
+    AsteroidField astField;
+    std::vector<unsigned char> respawnMask;
+    std::vector<size_t> spent;
+    bool over;
+
+    size_t shipCurrentRotation;
+
+    ProjectilePool shots;
+    std::vector<size_t> struck;
+
+    size_t asteroids_hit;
+    size_t shots_fired;
+
+    long long clock;
+    long long next_attack;
+    long long next_asteroid_move;
+    long long next_asteroid_increase;
+};
+
+#endif // WORLD_H
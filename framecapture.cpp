@@ -0,0 +1,189 @@
+/** @file framecapture.cpp
+ *  @brief This file contains the definition of the FrameCapture class.
+ */
+
+#include "framecapture.h"
+
+#include <QDir>
+#include <QPainter>
+#include <QTextStream>
+
+#include <chrono>
+
+/** How long a sleeping thread waits before it checks the ring again, in case it missed a wake up. */
+static const std::chrono::milliseconds POLL_INTERVAL(10);
+
+/**
+ * @brief FrameCapture::FrameCapture creates the directory, allocates every image of the ring and starts the writer.
+ * @param directory is the directory the frames are written to. It is created if it does not exist.
+ * @param format is the way the frames are written
+ * @param size is the size of a frame in pixels
+ * @param slots is the number of frames that can wait for the writer before frames are dropped
+ */
+FrameCapture::FrameCapture(const QString& directory, Format format, const QSize& size, int slots)
+    : dir(directory), format(format), blocking(false), head(0), tail(0), stopping(false), dropped(0) {
+
+    renderer.set_size(size);
+
+    ring.resize(slots > 0 ? slots : 1);
+    for(size_t i = 0; i < ring.size(); ++i) {
+        ring[i] = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    }
+
+    QDir().mkpath(dir);
+
+    if(format == RAW) {
+        QFile info(QDir(dir).filePath("frames.txt"));
+        if(info.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            QTextStream out(&info);
+            out << "width " << size.width() << "\n"
+                << "height " << size.height() << "\n"
+                << "bytes_per_line " << ring[0].bytesPerLine() << "\n"
+                << "format argb32_premultiplied\n";
+        }
+
+        raw.setFileName(QDir(dir).filePath("frames.raw"));
+        raw.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+
+    writer = std::thread(&FrameCapture::write_frames, this);
+}
+
+/**
+ * @brief FrameCapture::~FrameCapture writes the frames still in the ring and stops the writer.
+ */
+FrameCapture::~FrameCapture() {
+    stopping.store(true);
+    filled.notify_one();
+    writer.join();
+}
+
+/**
+ * @brief FrameCapture::is_open checks if the frames can be written
+ * @return true if the directory exists and, for RAW captures, frames.raw could be opened
+ */
+bool FrameCapture::is_open() const {
+    return QDir(dir).exists() && (format != RAW || raw.isOpen());
+}
+
+/**
+ * @brief FrameCapture::set_view changes the number of tiles that are visible in a frame.
+ * @param rows is the number of visible rows
+ * @param cols is the number of visible columns
+ */
+void FrameCapture::set_view(int rows, int cols) {
+    renderer.set_view(rows, cols);
+}
+
+/**
+ * @brief FrameCapture::set_blocking decides what capture() does when the ring is full. A game that is
+ * played live should drop the frame; a headless capture that has to keep every frame should wait.
+ * @param blocking is true to wait for the writer, false to drop the frame
+ */
+void FrameCapture::set_blocking(bool blocking) {
+    this->blocking = blocking;
+}
+
+/**
+ * @brief FrameCapture::capture draws a snapshot into the next free image of the ring and hands it to the writer.
+ * Must always be called from the same thread.
+ * @param snapshot is the snapshot to draw
+ * @param time is the game time to draw, in milliseconds
+ * @return true if the frame was captured, false if it was dropped because the ring was full
+ */
+bool FrameCapture::capture(const Snapshot& snapshot, double time) {
+    uint64_t next = head.load(std::memory_order_relaxed);
+
+    if(next - tail.load(std::memory_order_acquire) == ring.size()) {
+        if(!blocking) {
+            ++dropped;
+            return false;
+        }
+
+        std::unique_lock<std::mutex> guard(lock);
+        while(next - tail.load(std::memory_order_acquire) == ring.size()) {
+            emptied.wait_for(guard, POLL_INTERVAL);
+        }
+    }
+
+    QImage& frame = ring[next % ring.size()];
+    {
+        QPainter painter(&frame);
+        renderer.render(painter, snapshot, time);
+    }
+
+    head.store(next + 1, std::memory_order_release);
+    filled.notify_one();
+    return true;
+}
+
+/**
+ * @brief FrameCapture::flush waits until the writer has written every captured frame.
+ */
+void FrameCapture::flush() {
+    std::unique_lock<std::mutex> guard(lock);
+    while(tail.load(std::memory_order_acquire) != head.load(std::memory_order_relaxed)) {
+        emptied.wait_for(guard, POLL_INTERVAL);
+    }
+}
+
+/**
+ * @brief FrameCapture::frames_written gets the number of frames the writer has written
+ * @return the number of frames
+ */
+uint64_t FrameCapture::frames_written() const {
+    return tail.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief FrameCapture::frames_dropped gets the number of frames that did not fit in the ring
+ * @return the number of frames
+ */
+uint64_t FrameCapture::frames_dropped() const {
+    return dropped;
+}
+
+/**
+ * @brief FrameCapture::write_frames is the loop of the writer thread. It writes the images of the ring in the
+ * order they were captured and sleeps while the ring is empty. It returns once it is stopping and the ring is empty.
+ */
+void FrameCapture::write_frames() {
+    for(;;) {
+        uint64_t next = tail.load(std::memory_order_relaxed);
+
+        if(next == head.load(std::memory_order_acquire)) {
+            if(stopping.load()) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> guard(lock);
+            filled.wait_for(guard, POLL_INTERVAL);
+            continue;
+        }
+
+        write(ring[next % ring.size()], next);
+
+        tail.store(next + 1, std::memory_order_release);
+        emptied.notify_one();
+    }
+
+    if(raw.isOpen()) {
+        raw.close();
+    }
+}
+
+/**
+ * @brief FrameCapture::write writes one frame in the format of the capture
+ * @param frame is the image of the frame
+ * @param number is the number of the frame since the capture started
+ * @return true if the frame was written, false otherwise
+ */
+bool FrameCapture::write(const QImage& frame, uint64_t number) {
+    if(format == RAW) {
+        qint64 bytes = (qint64)frame.bytesPerLine() * frame.height();
+        return raw.write((const char*)frame.constBits(), bytes) == bytes;
+    }
+
+    QString name = QString("frame_%1.png").arg((qulonglong)number, 6, 10, QChar('0'));
+    return frame.save(QDir(dir).filePath(name), "PNG");
+}
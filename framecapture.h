@@ -0,0 +1,83 @@
+/** @file framecapture.h
+ *  @brief Class declaration for the FrameCapture class. Records the frames of a game to disk as an image sequence.
+ */
+
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include "snapshot.h"
+#include "boardrenderer.h"
+
+#include <QFile>
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The FrameCapture class draws snapshots of a game into a ring of images that are allocated once, and
+ * writes them to a directory on a background thread. It needs no window, so it works with the offscreen
+ * platform plugin.
+ *
+ * The game thread is the only one that fills images and the writer is the only one that empties them, so the
+ * two only share the head and tail counters of the ring. When the writer falls behind and the ring is full,
+ * the frame is dropped instead of waiting, unless the capture was made blocking for a headless run.
+ *
+ * PNG captures write frame_000000.png, frame_000001.png and so on. RAW captures append every frame to
+ * frames.raw as rows of 32 bit premultiplied ARGB pixels, and describe the frames in frames.txt.
+ */
+class FrameCapture {
+public:
+    /**
+     * @brief The Format enum lists the ways a frame can be written.
+     */
+    enum Format {
+        PNG,
+        RAW
+    };
+
+    static const int DEFAULT_SLOTS = 8;
+
+    FrameCapture(const QString& directory, Format format, const QSize& size, int slots = DEFAULT_SLOTS);
+    ~FrameCapture();
+
+    bool is_open() const;
+    void set_view(int rows, int cols);
+    void set_blocking(bool blocking);
+
+    bool capture(const Snapshot& snapshot, double time);
+    void flush();
+
+    uint64_t frames_written() const;
+    uint64_t frames_dropped() const;
+
+private:
+    void write_frames();
+    bool write(const QImage& frame, uint64_t number);
+
+    QString dir;
+    Format format;
+    bool blocking;
+
+    BoardRenderer renderer;
+    std::vector<QImage> ring;
+    QFile raw;
+
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    std::atomic<bool> stopping;
+    uint64_t dropped;
+
+    std::mutex lock;
+    std::condition_variable filled;
+    std::condition_variable emptied;
+    std::thread writer;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,43 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2015-10-23T09:49:22
+#
+# The Asteroids application. Built by Asteroids.pro.
+#
+#-------------------------------------------------
+
+QT       += core gui
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG   += c++14
+
+TARGET = Asteroids
+TEMPLATE = app
+
+
+SOURCES += main.cpp\
+        mainwindow.cpp \
+    boardwidget.cpp \
+    boardrenderer.cpp \
+    framecapture.cpp \
+    spritecache.cpp
+
+HEADERS  += mainwindow.h \
+    boardwidget.h \
+    boardrenderer.h \
+    framecapture.h \
+    spritecache.h
+
+FORMS    += mainwindow.ui \
+    outerspace.ui
+
+RESOURCES += \
+    res.qrc
+
+# Count the heap allocations of every frame for the profiler by replacing the
+# global operator new. Build with CONFIG+=no_count_allocations to keep the
+# default allocator; the allocations are then shown as zero.
+!no_count_allocations: SOURCES += allocationhooks.cpp
+
+include(core/core.pri)
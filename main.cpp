@@ -5,17 +5,401 @@
 
 /** @file main.cpp
  *  @brief This is the default main.cpp generated by Qt Creator. Launches the mainwindow which allows the game to be played.
+ *         Pass --grid-size N to play on an N by N gameboard and --time-scale X to run the game X times faster.
+ *         Pass --record FILE to record each game to FILE, and --replay FILE to replay a recorded game headless.
+ *         Pass --scores FILE to keep the high scores in FILE instead of the data directory of the application.
+ *         Pass --soak-restarts N to play N headless games back to back and check that memory stays flat.
+ *         Pass --soak-games N to play N games back to back through the windows of the game, without a display, and
+ *         check that the number of widgets and the memory stay flat.
+ *         Pass --capture DIR to write every frame to DIR, as PNG files or, with --capture-format raw, as one raw file.
+ *         Together with --replay FILE the recorded game is drawn frame by frame without a window.
+ *         Pass --batch N to play N headless games with a bot on every core and report how the bot fared. The bot is
+ *         chosen with --bot aim|random, and the difficulty with --num-asteroids, --asteroid-speed, --increase-rate,
+ *         --grid-size, --fragments N and --collisions 0|1. --threads T and --seed S are optional.
  */
 
 #include "mainwindow.h"
-#include "asteroid.h"
+#include "recording.h"
+#include "gameloop.h"
+#include "memoryusage.h"
+#include "batchrunner.h"
+#include "framecapture.h"
 #include <QApplication>
+#include <QGuiApplication>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+
+/**
+ * @brief replay plays a recorded game headless, as fast as possible, and checks its final score.
+ * @param path is the name of the recording
+ * @return 0 if the replay reproduced the recorded score, 1 otherwise
+ */
+static int replay(const char* path) {
+    Recording recording;
+    if(!recording.load(path)) {
+        std::cerr << "Could not read the recording " << path << std::endl;
+        return 1;
+    }
+
+    World world;
+    auto start = std::chrono::steady_clock::now();
+    bool matches = recording.replay(world);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Ticks: " << recording.ticks()
+              << "  Asteroids Destroyed: " << world.num_asteroids_hit() << " (recorded " << recording.num_asteroids_hit() << ")"
+              << "  Shots Fired: " << world.num_shots_fired() << " (recorded " << recording.num_shots_fired() << ")"
+              << "  Replay Time: " << seconds * 1000 << " ms" << std::endl;
+    std::cout << (matches ? "Replay matches the recording" : "Replay does NOT match the recording") << std::endl;
+
+    return matches ? 0 : 1;
+}
+
+/**
+ * @brief capture_format reads the format of a capture from the arguments
+ * @return FrameCapture::RAW if --capture-format raw was passed, FrameCapture::PNG otherwise
+ */
+static FrameCapture::Format capture_format(int argc, char *argv[]) {
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(std::strcmp(argv[i], "--capture-format") == 0 && std::strcmp(argv[i + 1], "raw") == 0) {
+            return FrameCapture::RAW;
+        }
+    }
+    return FrameCapture::PNG;
+}
+
+/**
+ * @brief capture_replay plays a recorded game headless and writes one frame for every 16 milliseconds of game time.
+ * The offscreen platform is used unless another one is set, so no display is needed. No frame is dropped:
+ * the game waits for the writer when it falls behind. The frames show the same viewport, at the same size, as the
+ * gameboard of the MainWindow, centered on the ship of the recorded game whatever the size of its gameboard.
+ * @param path is the name of the recording
+ * @param directory is the directory the frames are written to
+ * @return 0 if every frame was written and the replay reproduced the recorded score, 1 otherwise
+ */
+static int capture_replay(int argc, char *argv[], const char* path, const char* directory) {
+    const int FRAME_INTERVAL = 16;
+
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication a(argc, argv);
+
+    Recording recording;
+    if(!recording.load(path)) {
+        std::cerr << "Could not read the recording " << path << std::endl;
+        return 1;
+    }
+
+    const int view_rows = MainWindow::DEFAULT_VIEW;
+    const int view_cols = MainWindow::DEFAULT_VIEW;
+
+    FrameCapture capture(directory, capture_format(argc, argv),
+                         QSize(MainWindow::DEFAULT_BOARD_SIZE, MainWindow::DEFAULT_BOARD_SIZE));
+    if(!capture.is_open()) {
+        std::cerr << "Could not write to " << directory << std::endl;
+        return 1;
+    }
+    capture.set_blocking(true);
+    capture.set_view(view_rows, view_cols);
+
+    World world;
+    Snapshot snapshot;
+    long long next_frame = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    bool matches = recording.replay(world, [&](long long tick) {
+        if(tick * recording.tick_length() >= next_frame) {
+            snapshot.capture(world, view_rows, view_cols, tick);
+            capture.capture(snapshot, world.elapsed());
+            next_frame += FRAME_INTERVAL;
+        }
+    });
+    capture.flush();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Frames Written: " << capture.frames_written() << "  Capture Time: " << seconds * 1000 << " ms" << std::endl;
+    std::cout << (matches ? "Replay matches the recording" : "Replay does NOT match the recording") << std::endl;
+
+    return matches ? 0 : 1;
+}
+
+/**
+ * @brief option finds the value of an option in the arguments
+ * @param name is the name of the option, such as --threads
+ * @return the argument after the option, or null if the option was not passed
+ */
+static const char* option(int argc, char *argv[], const char* name) {
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief parse_int reads the integer value of an option. The whole value must be a number of at least low.
+ * @param name is the name of the option, for the error message
+ * @param text is the value that was passed, or null if the option was the last argument
+ * @param low is the lowest value allowed
+ * @param value is set to the number if it is valid
+ * @return false, after printing a usage error, if the value is missing, is not a number or is too low
+ */
+static bool parse_int(const char* name, const char* text, long low, int& value) {
+    if(text == nullptr) {
+        std::cerr << "Usage: " << name << " expects an integer of at least " << low << std::endl;
+        return false;
+    }
+
+    errno = 0;
+    char* end = nullptr;
+    long number = std::strtol(text, &end, 10);
+    if(end == text || *end != '\0' || errno == ERANGE || number < low || number > INT_MAX) {
+        std::cerr << "Usage: " << name << " expects an integer of at least " << low << ", not \"" << text << "\"" << std::endl;
+        return false;
+    }
+    value = (int)number;
+    return true;
+}
+
+/**
+ * @brief int_option reads the integer value of an option if it was passed
+ * @param name is the name of the option, such as --threads
+ * @param low is the lowest value allowed
+ * @param value is set to the number if the option was passed and is valid, and left as it is otherwise
+ * @return false if the option was passed with a value that is not valid
+ */
+static bool int_option(int argc, char *argv[], const char* name, long low, int& value) {
+    const char* text = option(argc, argv, name);
+    return text == nullptr || parse_int(name, text, low, value);
+}
+
+/**
+ * @brief batch plays a batch of headless games with a bot and prints the report of the BatchRunner.
+ * Every period, size and count must be positive; the number of asteroids and of fragments may be zero.
+ * @param games is the number of games to play
+ * @return 0, or 1 if an option has a value that is not valid
+ */
+static int batch(int argc, char *argv[], int games) {
+    World::Settings settings;
+    int grid_size = 0;
+    int collisions = settings.asteroid_collisions ? 1 : 0;
+    int threads = 0;
+
+    if(!int_option(argc, argv, "--num-asteroids", 0, settings.num_asteroids)
+            || !int_option(argc, argv, "--asteroid-speed", 1, settings.asteroid_speed)
+            || !int_option(argc, argv, "--increase-rate", 1, settings.rate_of_num_astr_increase)
+            || !int_option(argc, argv, "--grid-size", 1, grid_size)
+            || !int_option(argc, argv, "--fragments", 0, settings.asteroid_fragments)
+            || !int_option(argc, argv, "--collisions", 0, collisions)
+            || !int_option(argc, argv, "--threads", 1, threads)) {
+        return 1;
+    }
+    if(grid_size > 0) {
+        settings.grid_width = settings.grid_length = grid_size;
+        settings.ship_x = settings.ship_y = settings.grid_width / 2;
+    }
+    settings.asteroid_collisions = collisions != 0;
+
+    if(const char* value = option(argc, argv, "--seed")) {
+        char* end = nullptr;
+        errno = 0;
+        settings.seed = std::strtoull(value, &end, 10);
+        if(end == value || *end != '\0' || errno == ERANGE) {
+            std::cerr << "Usage: --seed expects an unsigned integer, not \"" << value << "\"" << std::endl;
+            return 1;
+        }
+    }
+
+    const char* bot = option(argc, argv, "--bot");
+    bool random = bot != nullptr && std::strcmp(bot, "random") == 0;
+
+    BatchRunner runner(threads);
+    BatchRunner::Report report = runner.run(settings, games, [random]() {
+        return random ? std::unique_ptr<Bot>(new RandomBot) : std::unique_ptr<Bot>(new AimBot);
+    });
+
+    std::cout << "Bot: " << (random ? "random" : "aim")
+              << "  Asteroids: " << settings.num_asteroids << "  Asteroid Speed: " << settings.asteroid_speed
+              << "  Increase Rate: " << settings.rate_of_num_astr_increase << "  Grid: " << settings.grid_length
+              << "  Fragments: " << settings.asteroid_fragments << "  Collisions: " << (settings.asteroid_collisions ? "on" : "off") << std::endl;
+    std::cout << report.summary() << std::endl;
+    return 0;
+}
+
+static const size_t ALLOWED_GROWTH = 1024 * 1024;
+
+/**
+ * @brief soak_restarts plays games headless, back to back in the same World, with a bot that turns and fires
+ * at random. The resident memory is sampled once the first tenth of the games has warmed up the storage, and
+ * again at the end.
+ * @param games is the number of games to play
+ * @return 0 if the memory grew by less than a megabyte after warming up, 1 otherwise
+ */
+static int soak_restarts(int games) {
+    World world;
+    GameLoop loop(&world);
+    Rng bot;
+    size_t warm = 0;
+
+    for(int game = 0; game < games; ++game) {
+        World::Settings settings;
+        settings.seed = game;
+        world.set_settings(settings);
+        world.reset();
+        loop.reset();
+
+        while(!world.is_over()) {
+            loop.advance(GameLoop::MAX_FRAME_TIME);
+            world.apply((World::Input)bot.uniform(World::ROTATE_LEFT, World::FIRE));
+        }
+
+        if(game == games / 10) {
+            warm = resident_memory();
+        }
+    }
+
+    size_t end = resident_memory();
+    bool flat = end < warm + ALLOWED_GROWTH;
+
+    std::cout << "Games: " << games << "  Resident Memory After Warm Up: " << warm / 1024 << " KiB"
+              << "  At End: " << end / 1024 << " KiB" << std::endl;
+    std::cout << (flat ? "Memory stayed flat" : "Memory GREW during the soak") << std::endl;
+
+    return flat ? 0 : 1;
+}
+
+/**
+ * @brief soak_games plays games back to back through the MainWindow, the way a kiosk that runs for weeks does, with
+ * the offscreen platform unless another one is set. Every game starts from the gameover screen of the one before and
+ * runs a thousand times faster than real time until an asteroid hits the ship. The scores go to a score log in a
+ * temporary directory that is removed afterwards, so the high scores of the game are left alone. The number of widgets
+ * and the resident memory are sampled once the first tenth of the games has warmed up, and again at the end.
+ * @param games is the number of games to play, at least one
+ * @return 0 if the number of widgets did not change and the memory grew by less than a megabyte, 1 otherwise
+ */
+static int soak_games(int argc, char *argv[], int games) {
+    const double TIME_SCALE = 1000;
+
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication a(argc, argv);
+
+    QTemporaryDir scoreDir;
+    MainWindow w;
+    if(!scoreDir.isValid() || !w.set_score_path(scoreDir.filePath("scores.log").toStdString())) {
+        std::cerr << "Could not create a score log for the soak" << std::endl;
+        return 1;
+    }
+    w.FRAME_INTERVAL = 1;
+    w.set_time_scale(TIME_SCALE);
+    w.show();
+
+    int played = 0;
+    int warm_widgets = 0;
+    size_t warm_memory = 0;
+
+    QObject::connect(&w, &MainWindow::game_over, [&]() {
+        ++played;
+        if(played == games / 10 + 1) {
+            warm_widgets = QApplication::allWidgets().size();
+            warm_memory = resident_memory();
+        }
+
+        if(played < games) {
+            QTimer::singleShot(0, &w, SLOT(startGame()));
+        } else {
+            a.quit();
+        }
+    });
+
+    QTimer::singleShot(0, &w, SLOT(startGame()));
+    a.exec();
+
+    int end_widgets = QApplication::allWidgets().size();
+    size_t end_memory = resident_memory();
+    bool flat = end_widgets == warm_widgets && end_memory < warm_memory + ALLOWED_GROWTH;
+
+    std::cout << "Games: " << played << "  Widgets After Warm Up: " << warm_widgets << "  At End: " << end_widgets
+              << "  Resident Memory After Warm Up: " << warm_memory / 1024 << " KiB"
+              << "  At End: " << end_memory / 1024 << " KiB" << std::endl;
+    std::cout << (flat ? "Widgets and memory stayed flat" : "Widgets or memory GREW during the soak") << std::endl;
+
+    return flat ? 0 : 1;
+}
 
 int main(int argc, char *argv[])
 {
+    const char* capture_dir = nullptr;
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(std::strcmp(argv[i], "--capture") == 0) {
+            capture_dir = argv[i + 1];
+        }
+    }
+
+    for(int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(std::strcmp(argv[i], "--replay") == 0 && value != nullptr) {
+            return capture_dir != nullptr ? capture_replay(argc, argv, value, capture_dir) : replay(value);
+        }
+        if(std::strcmp(argv[i], "--batch") == 0) {
+            int games = 0;
+            return parse_int("--batch", value, 1, games) ? batch(argc, argv, games) : 1;
+        }
+        if(std::strcmp(argv[i], "--soak-restarts") == 0) {
+            int games = 0;
+            return parse_int("--soak-restarts", value, 1, games) ? soak_restarts(games) : 1;
+        }
+        if(std::strcmp(argv[i], "--soak-games") == 0) {
+            int games = 0;
+            return parse_int("--soak-games", value, 1, games) ? soak_games(argc, argv, games) : 1;
+        }
+    }
+
     QApplication a(argc, argv);
     MainWindow w;
+
+    QStringList args = a.arguments();
+    int grid_size = args.indexOf("--grid-size");
+    if(grid_size != -1 && grid_size + 1 < args.size()) {
+        w.set_grid_size(args.at(grid_size + 1).toInt());
+    }
+
+    int time_scale = args.indexOf("--time-scale");
+    if(time_scale != -1 && time_scale + 1 < args.size()) {
+        w.set_time_scale(args.at(time_scale + 1).toDouble());
+    }
+
+    int record = args.indexOf("--record");
+    if(record != -1 && record + 1 < args.size()) {
+        w.set_record_path(args.at(record + 1).toStdString());
+    }
+
+    int score_path = args.indexOf("--scores");
+    std::string scores = MainWindow::default_score_path();
+    if(score_path != -1 && score_path + 1 < args.size()) {
+        scores = args.at(score_path + 1).toStdString();
+    }
+    if(!w.set_score_path(scores)) {
+        std::cerr << "Could not open the score log " << scores << ", it may be in use by another instance" << std::endl;
+    }
+
+    std::unique_ptr<FrameCapture> capture;
+    if(capture_dir != nullptr) {
+        capture.reset(new FrameCapture(capture_dir, capture_format(argc, argv), QSize(w.BOARDWIDTH, w.BOARDHEIGHT)));
+        w.set_capture(capture.get());
+    }
+
     w.show();
 
     return a.exec();
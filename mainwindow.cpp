@@ -6,11 +6,11 @@
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
-#include "asteroid.h"
 
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <chrono>
 
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -25,59 +25,65 @@
 #include <QKeyEvent>
 #include <QTimer>
 #include <QString>
-
-const int NORTH = 0;
-const int NORTHEAST = 45;
-const int EAST = 90;
-const int SOUTHEAST = 135;
-const int SOUTH = 180;
-const int SOUTHWEST = 225;
-const int WEST = 270;
-const int NORTHWEST = 315;
+#include <QFont>
+#include <QDir>
+#include <QStandardPaths>
 
 /**
  * @brief MainWindow::MainWindow is the constructor for the entire application. MainWindow contains a stacked widget
- * which manages the welcome screen and the gameboard.
+ * which manages the welcome screen and the gameboard. No score log is opened until set_score_path() is called, so
+ * the high scores start empty. Only the welcome screen is built here; the gameboard and the
+ * gameover screen are built the first time they are shown and reused after that. The time the constructor takes is
+ * shown with the timings of the gameover screen.
  * @param parent is a default parameter
  */
-MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow) {
+MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow), loop(&world), simulation(&world, &loop) {
+    QElapsedTimer startupClock;
+    startupClock.start();
+
     ui->setupUi(this);
 
     GRIDWIDTH = 23;
     GRIDLENGTH = 23;
-    BOARDWIDTH = 575;
-    BOARDHEIGHT = 575;
+    VIEWWIDTH = DEFAULT_VIEW;
+    VIEWLENGTH = DEFAULT_VIEW;
+    BOARDWIDTH = DEFAULT_BOARD_SIZE;
+    BOARDHEIGHT = DEFAULT_BOARD_SIZE;
 
     NUMASTEROIDS = 3;
     SIZE_OF_ASTEROID = 1;
     ASTEROID_SPEED = 600;
     RATE_OF_NUM_ASTR_INCREASE = 30*1000;
+    ASTEROID_FRAGMENTS = 2;
+    ASTEROID_COLLISIONS = true;
 
     TOP_LEFT_XCORD_SHIP = 11;
     TOP_LEFT_YCORD_SHIP = 11;
     SIZE_OF_SHIP = 1;
     ATTACK_SPEED = 50;
 
+    FRAME_INTERVAL = 16;
+
     // for stacked_widget
     stacked_widget = new QStackedWidget;
     QVBoxLayout* stacked_layout = new QVBoxLayout;
     central = new QWidget;
 
-    shipDiagonal = false;
-    shipCurrentRotation = 0;
-    shipLabel = new QLabel;
-    shipImage = QImage(":/images/spaceship.png");
-    shipImageRotated = QImage(":/images/spaceshipRotated.png");
-    shipPixmap.convertFromImage(shipImage);
-
-    asteroidTimer = new QTimer;
-    connect(asteroidTimer, SIGNAL(timeout()), this, SLOT(moveAsteroids()));
+    // decode every image and render the ship frames before the first game starts
+    SpriteCache::shared();
 
-    attackTimer = new QTimer;
-    connect(attackTimer, SIGNAL(timeout()), this, SLOT(moveAttack()));
+    gameBoard = nullptr;
+    gameover_screen = nullptr;
+    capture = nullptr;
+    firstFramePending = false;
+    firstFrameTime = 0;
+    shownInput = 0;
+    measuredInput = 0;
+    simulation.set_recording(&recording);
 
-    increase_number_of_asteroids_timer = new QTimer;
-    connect(increase_number_of_asteroids_timer, SIGNAL(timeout()), this, SLOT(increase_num_asteroids()));
+    frameTimer = new QTimer;
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(frameTimer, SIGNAL(timeout()), this, SLOT(advanceFrame()));
 
     QWidget* base = new QWidget;
     QVBoxLayout* bottomLayout = new QVBoxLayout(base);
@@ -87,7 +93,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
 
     QHBoxLayout* topHbox = new QHBoxLayout(welcomeWid);
     QLabel* welcome = new QLabel("Asteroids!");
-    welcome->setStyleSheet("QLabel { font-size: 30px }");
+    QFont bannerFont = welcome->font();
+    bannerFont.setPixelSize(30);
+    welcome->setFont(bannerFont);
     welcome->setAlignment(Qt::AlignCenter);
     topHbox->addWidget(welcome);
 
@@ -105,9 +113,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     startAndHow->addWidget(startGame);
     leftbottom->setLayout(startAndHow);
 
-    QTextEdit* highScores = new QTextEdit;
-    highScores->setText("<h2><center>How To Play: </center></h2> <p>Use the spacebar to attack.</p> <p>Use the left arrow key to rotate the ship to its left.</p> <p>Use the right arrow key to rotate the ship to its right.</p> <p>The number of asteroids increases the longer you survive.</p>");
+    highScores = new QTextEdit;
     highScores->setReadOnly(true);
+    show_high_scores();
     //highScores->setMinimumHeight(400);
     highscore->addWidget(highScores);
     rightbottom->setLayout(highscore);
@@ -127,58 +135,109 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
 
     setFixedSize(475,300);
     setCentralWidget(central);
+
+    startupTime = startupClock.nsecsElapsed();
 }
 
 /**
- * @brief MainWindow::createGameBoard creates our gameboard. Instantiates the grid tiles, adds the ship images,
- * and sets up the asteroid and attack images.
+ * @brief MainWindow::createGameBoard sets up our gameboard. Starts a new game in the world and the simulation
+ * thread that steps it. The board widget which draws it is created for the first game and reused by every game after it.
+ * The first snapshot is shown right away rather than at the next frame, and the time until it has been painted is
+ * measured by board_painted().
  * @return a pointer to our gameboard
  */
 QWidget* MainWindow::createGameBoard() {
 
-    QSize tileSize(BOARDWIDTH/GRIDWIDTH,BOARDHEIGHT/GRIDLENGTH);
-
-    gameBoard = new QWidget;
+    gameStartClock.start();
+    firstFramePending = true;
+    shownInput = 0;
+    measuredInput = 0;
+
+    simulation.stop();
+
+    World::Settings settings;
+    settings.grid_width = GRIDWIDTH;
+    settings.grid_length = GRIDLENGTH;
+    settings.num_asteroids = NUMASTEROIDS;
+    settings.asteroid_speed = ASTEROID_SPEED;
+    settings.rate_of_num_astr_increase = RATE_OF_NUM_ASTR_INCREASE;
+    settings.asteroid_fragments = ASTEROID_FRAGMENTS;
+    settings.asteroid_collisions = ASTEROID_COLLISIONS;
+    settings.ship_x = TOP_LEFT_XCORD_SHIP;
+    settings.ship_y = TOP_LEFT_YCORD_SHIP;
+    settings.attack_speed = ATTACK_SPEED;
+    settings.seed = std::chrono::system_clock::now().time_since_epoch().count();
+
+    world.set_settings(settings);
+    world.reset();
+    world.set_profiler(&profiler);
+    profiler.reset();
+    recording.start(world.settings(), loop.tick_length());
+
+    if(gameBoard == nullptr) {
+        gameBoard = new BoardWidget;
+        gameBoard->set_profiler(&profiler);
+        connect(gameBoard, SIGNAL(painted()), this, SLOT(board_painted()));
+    }
+    gameBoard->set_view(VIEWLENGTH, VIEWWIDTH);
     gameBoard->setFixedSize(BOARDWIDTH, BOARDHEIGHT);
-    grid = new QGridLayout(gameBoard);
-
-    gridLabels = new QLabel*[GRIDWIDTH * GRIDLENGTH];
-
-    for (size_t i = 0, size = GRIDLENGTH*GRIDWIDTH; i < size; ++i ) {
-        gridLabels[i] = new QLabel;
-        gridLabels[i]->setStyleSheet("QLabel { background-color: black }; ");
-        gridLabels[i]->setFixedSize(tileSize);
+    if(capture != nullptr) {
+        capture->set_view(VIEWLENGTH, VIEWWIDTH);
     }
 
-    for (size_t i = 0; i < GRIDLENGTH; ++i) {
-        for (size_t j = 0; j < GRIDWIDTH; ++j) {
-            grid->addWidget(gridLabels[i * GRIDLENGTH + j], i, j);
-        }
-    }
+    loop.reset();
+    simulation.set_view(VIEWLENGTH, VIEWWIDTH);
+    simulation.start();
 
-    grid->addWidget(shipLabel, TOP_LEFT_XCORD_SHIP, TOP_LEFT_YCORD_SHIP, SIZE_OF_SHIP, SIZE_OF_SHIP, Qt::AlignCenter);
+    SnapshotBuffer& snapshots = simulation.snapshots();
+    snapshots.update();
+    gameBoard->show_snapshot(&snapshots.front(), snapshots.front().elapsed);
 
-    for(size_t i = 0; i < NUMASTEROIDS; ++i) {
-        Asteroid a;
-        astVec.push_back(a);
-    }
+    frameClock.start();
+    snapshotClock.start();
+    frameTimer->start(FRAME_INTERVAL);
 
-    set_up_attack();
-    isAttacking = false;
+    return gameBoard;
+}
 
-    set_up_asteroids();
+/**
+ * @brief MainWindow::board_painted measures the time from the start of a game to the first frame painted on screen,
+ * for the timings of the gameover screen. For every input, the time from the key press to the first frame painted with
+ * the input applied is recorded by the profiler.
+ */
+void MainWindow::board_painted() {
+    if(shownInput != measuredInput) {
+        long long now = std::chrono::duration_cast<std::chrono::nanoseconds>(Simulation::Clock::now().time_since_epoch()).count();
+        profiler.record(Profiler::INPUT_LATENCY, now - shownInput);
+        measuredInput = shownInput;
+    }
 
-    num_shots_fired = 0;
-    num_asteroids_hit = 0;
+    if(!firstFramePending) {
+        return;
+    }
 
-    asteroidTimer->start(ASTEROID_SPEED);
-    attackTimer->start(ATTACK_SPEED);
-    increase_number_of_asteroids_timer->start(RATE_OF_NUM_ASTR_INCREASE);
+    firstFramePending = false;
+    firstFrameTime = gameStartClock.nsecsElapsed();
+}
 
-    grid->setSpacing(0);
-    gameBoard->setLayout(grid);
+/**
+ * @brief MainWindow::set_grid_size changes the size of the gameboard used by the next game. The ship is placed
+ * in the middle of the gameboard. The viewport keeps its size, so a larger gameboard costs no more to draw.
+ * @param size is the number of tiles on each side of the gameboard, at most World::Settings::MAX_GRID_SIZE
+ */
+void MainWindow::set_grid_size(int size) {
+    GRIDWIDTH = size;
+    GRIDLENGTH = size;
+    TOP_LEFT_XCORD_SHIP = size / 2;
+    TOP_LEFT_YCORD_SHIP = size / 2;
+}
 
-    return gameBoard;
+/**
+ * @brief MainWindow::set_time_scale changes how fast the game runs compared to real time.
+ * @param scale is the multiplier, 1 for normal speed and 100 to fast-forward a hundred times
+ */
+void MainWindow::set_time_scale(double scale) {
+    loop.set_time_scale(scale);
 }
 
 /**
@@ -186,66 +245,27 @@ QWidget* MainWindow::createGameBoard() {
  * If the user presses the right key, the ship turns to its right.
  * If the user presses the left key, the ship turns to its left.
  * If the user presses the spacebar, the ship fires its attack.
+ * If the user presses F3, the timing overlay is shown or hidden.
  * If any other key is pressed, nothing happens.
  * @param e is the default parameter for the function
  */
 void MainWindow::keyPressEvent(QKeyEvent *e) {
     switch(e->key()) {
     case (Qt::Key_Left): {
-        shipCurrentRotation += 315;
-        rotateShip();
+        apply_input(World::ROTATE_LEFT);
         break;
     }
     case (Qt::Key_Right): {
-        shipCurrentRotation += 45;
-        rotateShip();
+        apply_input(World::ROTATE_RIGHT);
         break;
     }
     case (Qt::Key_Space): {
-
-        if (!isAttacking) {
-            isAttacking = true;
-            num_shots_fired++;
-
-            attackX = TOP_LEFT_XCORD_SHIP;
-            attackY = TOP_LEFT_YCORD_SHIP;
-
-            switch(shipCurrentRotation % 360) {
-            case(NORTH):
-                attackXDirection = -1;
-                attackYDirection = 0;
-                break;
-            case(NORTHEAST):
-                attackXDirection = -1;
-                attackYDirection = 1;
-                break;
-            case(EAST):
-                attackXDirection = 0;
-                attackYDirection = 1;
-                break;
-            case(SOUTHEAST):
-                attackXDirection = 1;
-                attackYDirection = 1;
-                break;
-            case(SOUTH):
-                attackXDirection = 1;
-                attackYDirection = 0;
-                break;
-            case(SOUTHWEST):
-                attackXDirection = 1;
-                attackYDirection = -1;
-                break;
-            case(WEST):
-                attackXDirection = 0;
-                attackYDirection = -1;
-                break;
-            case(NORTHWEST):
-                attackXDirection = -1;
-                attackYDirection = -1;
-                break;
-            default:
-                break;
-            }
+        apply_input(World::FIRE);
+        break;
+    }
+    case (Qt::Key_F3): {
+        if(gameBoard != nullptr) {
+            gameBoard->toggle_overlay();
         }
         break;
     }
@@ -255,158 +275,181 @@ void MainWindow::keyPressEvent(QKeyEvent *e) {
 }
 
 /**
- * @brief MainWindow::rotateShip
- * This function rotates the ship image. The function takes advantage of the fact that only eight orientations
- * of the ship are possible. As a result, we can only have the ship facing a cardinal direction (N, S, E, W) or not
- * (NW, SW, SE, NE).
+ * @brief MainWindow::apply_input queues an input of the player for the simulation thread, which applies it
+ * before its next tick and records it. Inputs are ignored while no game is running.
+ * @param input is the input
  */
-void MainWindow::rotateShip() {
-
-    QTransform trans;
-    QImage tempShip;
-
-    if(shipDiagonal)
-        shipDiagonal = false;
-    else
-        shipDiagonal = true;
-
-    if(shipDiagonal) {
-        trans.rotate(shipCurrentRotation - 45);
-        tempShip = shipImageRotated.transformed(trans);
-        shipPixmap.convertFromImage(tempShip);
-    }
-    else {
-        trans.rotate(shipCurrentRotation);
-        tempShip = shipImage.transformed(trans);
-        shipPixmap.convertFromImage(tempShip);
+void MainWindow::apply_input(World::Input input) {
+    if(!simulation.is_running()) {
+        return;
     }
 
-    repaint();
+    simulation.push(input);
 }
 
 /**
- * @brief MainWindow::set_up_attack
- * This function contructs the attack image.
+ * @brief MainWindow::set_record_path makes every game get recorded to a file, which can be replayed with --replay.
+ * The file is written when the game is over and holds the last game played.
+ * @param path is the name of the file
  */
-void MainWindow::set_up_attack() {
-    attackLabel = new QLabel;
-    attackLabel->setPixmap(QPixmap(":/images/attack.png"));
-    attackLabel->setScaledContents(true);
+void MainWindow::set_record_path(const std::string& path) {
+    recordPath = path;
+}
 
+/**
+ * @brief MainWindow::set_capture makes every frame of a game get drawn a second time into the capture, which
+ * writes it to disk on its own thread. Frames are dropped rather than slowing the game down.
+ * @param capture is the capture, or null to stop capturing. It must stay valid while games are played.
+ */
+void MainWindow::set_capture(FrameCapture* capture) {
+    this->capture = capture;
 }
 
 /**
- * @brief MainWindow::set_up_asteroids
- * This function iterates through the vector of Asteroid objects and adds the Asteroids
- * to the gridlayout.
+ * @brief MainWindow::reset_gameboard is used to return the gameboard widget to its default statement.
+ * This is the state in which it existed before creation. The function is called when the game ends.
  */
-void MainWindow::set_up_asteroids() {
+void MainWindow::reset_gameboard() {
 
-    for(auto& astr : astVec) {
-        grid->addWidget(astr.getLabel(), astr.getX(), astr.getY(), SIZE_OF_ASTEROID, SIZE_OF_ASTEROID, Qt::AlignCenter);
+    frameTimer->stop();
+    simulation.stop();
+    gameBoard->show_snapshot(nullptr, 0);
+
+    recording.finish(world, loop.ticks());
+    if(!recordPath.empty()) {
+        recording.save(recordPath);
     }
+
+    ScoreLog::Score result;
+    result.time = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    result.seed = world.settings().seed;
+    result.elapsed = world.elapsed();
+    result.asteroids_hit = world.num_asteroids_hit();
+    result.shots_fired = world.num_shots_fired();
+    scores.append(result);
+    show_high_scores();
 }
 
 /**
- * @brief MainWindow::is_attack_in_valid_range
- * This function checks that there is at least one grid between the attack image
- * and the border of the grid.
- * @return true is there is at least one grid, false otherwise.
+ * @brief MainWindow::default_score_path gets the score log the game keeps its high scores in: scores.log in the data
+ * directory of the application, which is created if it does not exist.
+ * @return the name of the file
  */
-bool MainWindow::is_attack_in_valid_range() {
-    return attackX > 0 && attackX < GRIDLENGTH - 1 && attackY > 0 && attackY < GRIDWIDTH - 1;
+std::string MainWindow::default_score_path() {
+    QString scoreDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(scoreDir);
+    return (scoreDir + "/scores.log").toStdString();
 }
 
 /**
- * @brief MainWindow::paintEvent
- * @param e is the default paramater for the paintEvent function
- * This function redraws the ship image (which may have rotated) and
- * draws the asteroids on the grid.
+ * @brief MainWindow::set_score_path makes the high scores come from a score log, which is created if it does
+ * not exist.
+ * @param path is the name of the file
+ * @return false if the file could not be opened, in which case scores are not kept
  */
-void MainWindow::paintEvent(QPaintEvent* e) {
-    shipLabel->setPixmap(shipPixmap);
-    shipLabel->setScaledContents(true);
-
-    set_up_asteroids();
+bool MainWindow::set_score_path(const std::string& path) {
+    bool opened = scores.open(path);
+    show_high_scores();
+    return opened;
 }
 
 /**
- * @brief MainWindow::reset_gameboard is used to return the gameboard widget to its default statement.
- * This is the state in which it existed before creation. The function is called when the game ends.
+ * @brief MainWindow::show_high_scores fills the right-hand panel of the welcome screen with the best scores of the
+ * score log, followed by the instructions. Only the best scores are read, however many games the log holds.
  */
-void MainWindow::reset_gameboard() {
+void MainWindow::show_high_scores() {
+    std::stringstream html;
+    html << "<h2><center>High Scores: </center></h2>";
 
-    attackTimer->stop();
-    asteroidTimer->stop();
-    increase_number_of_asteroids_timer->stop();
-    NUMASTEROIDS = 3;
-    astVec.clear();
-}
+    const std::vector<ScoreLog::Score>& top = scores.top();
+    if(top.empty()) {
+        html << "<p>No games played yet.</p>";
+    } else {
+        html << "<ol>";
+        for(size_t i = 0; i < top.size(); ++i) {
+            html << "<li>" << top[i].asteroids_hit << " destroyed with " << top[i].shots_fired << " shots</li>";
+        }
+        html << "</ol>";
+    }
+    html << "<p>" << scores.size() << " games played.</p>";
 
-/**
- * @brief MainWindow::collided_with_attack checks if the ship's attack has collided with an asteroid.
- * @param a is the asteroid that we are checking against for a collision.
- * @return true if a collision occured, false otherwise
- */
-bool MainWindow::collided_with_attack(const Asteroid &a) const {
-    return a.getX() == attackX && a.getY() == attackY;
+    html << "<h2><center>How To Play: </center></h2> <p>Use the spacebar to attack.</p> <p>Use the left arrow key to rotate the ship to its left.</p> <p>Use the right arrow key to rotate the ship to its right.</p> <p>The number of asteroids increases the longer you survive.</p>";
+    highScores->setText(QString::fromStdString(html.str()));
 }
 
 /**
- * @brief MainWindow::reset_attack removes the attack image from the gameboard.
- * This function is called if the attack image leaves the screen or if it collides
- * with an asteroid.
+ * @brief MainWindow::show_page makes a page of the stacked widget visible. Every page is added the first time it is
+ * shown and stays in the stacked widget after that, so the stacked widget never holds more than the welcome screen,
+ * the gameboard and the gameover screen, however many games are played.
+ * @param page is the page, which is created once and reused
  */
-void MainWindow::reset_attack() {
-    grid->removeWidget(attackLabel);
-    delete attackLabel;
-    attackLabel = nullptr;
-    isAttacking = false;
-    attackX = TOP_LEFT_XCORD_SHIP;
-    attackY = TOP_LEFT_YCORD_SHIP;
+void MainWindow::show_page(QWidget* page) {
+    if(stacked_widget->indexOf(page) == -1) {
+        stacked_widget->addWidget(page);
+    }
+    stacked_widget->setCurrentWidget(page);
 }
 
 /**
- * @brief MainWindow::create_gameover_screen handles the creation of the gameover window that appears once an asteroid collides with a ship.
+ * @brief MainWindow::create_gameover_screen handles the gameover window that appears once an asteroid collides with a ship.
  * The window displays the number of asteroids hit by the user and the accuracy with which the user shot during his play.
+ * Below them, the startup time, the time to the first frame and the p50, p99 and max of every phase measured by the
+ * profiler are shown and written to standard output. The window is built for the first game over and its text is
+ * updated for every game after it.
  * @return a pointer to the gameover window widget.
  */
 QWidget* MainWindow::create_gameover_screen() {
 
+    if(gameover_screen == nullptr) {
+        gameover_screen = new QWidget;
+        gameover_layout = new QVBoxLayout(gameover_screen);
+        gameover_banner = new QLabel;
+
+        gameover_banner->setText("Game Over");
+        QFont bannerFont = gameover_banner->font();
+        bannerFont.setPixelSize(30);
+        gameover_banner->setFont(bannerFont);
+        gameover_banner->setAlignment(Qt::AlignHCenter);
+        gameover_layout->addWidget(gameover_banner);
+
+        score = new QLabel;
+        score->setAlignment(Qt::AlignHCenter);
+        gameover_layout->addWidget(score);
+
+        QFont mono("monospace");
+        mono.setStyleHint(QFont::TypeWriter);
+        timings = new QLabel;
+        timings->setFont(mono);
+        timings->setAlignment(Qt::AlignHCenter);
+        gameover_layout->addWidget(timings);
+
+        QPushButton* return_home = new QPushButton;
+        return_home->setText("Return to Main Menu");
+        QObject::connect(return_home, SIGNAL(clicked(bool)), this, SLOT(return_to_main_menu()));
+        gameover_layout->addWidget(return_home);
+        gameover_screen->setLayout(gameover_layout);
+    }
+
     std::stringstream asteroids_hit;
-    asteroids_hit << num_asteroids_hit;
+    asteroids_hit << world.num_asteroids_hit();
 
     std::stringstream accuracy;
     std::string accuracy_string;
 
-    if(num_shots_fired != 0) {
-        accuracy << (num_asteroids_hit * 1.0/num_shots_fired*100);
+    if(world.num_shots_fired() != 0) {
+        accuracy << (world.num_asteroids_hit() * 1.0/world.num_shots_fired()*100);
         accuracy_string = "     Accuracy: " + (accuracy.str()).substr(0, 5) + "%";
     } else {
         accuracy_string = "     Accuracy: No shots were fired!";
     }
 
-    QString q = QString::fromStdString("Number of Asteroids Destroyed: " + asteroids_hit.str() + accuracy_string);
-
-    gameover_screen = new QWidget;
-    gameover_layout = new QVBoxLayout(gameover_screen);
-    gameover_banner = new QLabel;
-
-    gameover_banner->setText("Game Over");
-    gameover_banner->setStyleSheet("QLabel { font-size: 30px; } ");
-    gameover_banner->setAlignment(Qt::AlignHCenter);
-    gameover_layout->addWidget(gameover_banner);
-
-    score = new QLabel;
-    score->setText(q);
-    score->setAlignment(Qt::AlignHCenter);
-    gameover_layout->addWidget(score);
+    score->setText(QString::fromStdString("Number of Asteroids Destroyed: " + asteroids_hit.str() + accuracy_string));
 
-    QPushButton* return_home = new QPushButton;
-    return_home->setText("Return to Main Menu");
-    QObject::connect(return_home, SIGNAL(clicked(bool)), this, SLOT(return_to_main_menu()));
-    gameover_layout->addWidget(return_home);
-    gameover_screen->setLayout(gameover_layout);
+    std::stringstream summary;
+    summary << "startup: " << startupTime / 1000000 << " ms  first frame: " << firstFrameTime / 1000000 << " ms\n"
+            << profiler.summary();
+    std::cout << summary.str() << std::endl;
+    timings->setText(QString::fromStdString(summary.str()));
 
     return gameover_screen;
 }
@@ -7,9 +7,21 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
-#include "asteroid.h"
+#include "world.h"
+#include "gameloop.h"
+#include "simulation.h"
+#include "recording.h"
+#include "scorelog.h"
+#include "profiler.h"
+#include "alloccounter.h"
+#include "boardwidget.h"
+#include "framecapture.h"
+#include "spritecache.h"
 
 #include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdlib>
 
 #include <QMainWindow>
 #include <QPixmap>
@@ -19,6 +31,8 @@
 #include <QWidget>
 #include <QStackedWidget>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QTextEdit>
 
 namespace Ui {
 class MainWindow;
@@ -34,92 +48,83 @@ class MainWindow : public QMainWindow
 public slots:
     /**
      * @brief startGame
-     * This function starts the game. We put the gameboard on the top of the stacked widget
+     * This function starts the game. We show the gameboard page of the stacked widget
      * and make the game visible. We also resize the MainWindow so that the board is unobstructed.
      */
     void startGame() {
-        stacked_widget->insertWidget(1, createGameBoard());
-        stacked_widget->setCurrentIndex(1);
+        show_page(createGameBoard());
         setFixedSize(595,595);
     }
 
     /**
-     * @brief moveAsteroids
-     * This function handles the animation of the Asteroid images.
+     * @brief advanceFrame
+     * This function runs once per frame. The world is stepped by the simulation thread; the frame takes the
+     * newest snapshot it published and shows it at the game time that has passed since the snapshot
+     * so the asteroids and the shots slide smoothly. The board schedules a repaint of the tiles that changed.
      */
-    void moveAsteroids() {
-
-        for(auto& astr : astVec) {
-            astr.setX(astr.getX() + astr.getXdir());
-            astr.setY(astr.getY() + astr.getYdir());
-
-            if(astr.collided_with_ship()) {
-                reset_gameboard();
-                stacked_widget->insertWidget(2, create_gameover_screen());
-                stacked_widget->setCurrentIndex(2);
-                setFixedSize(475,300);
-                return;
-            }
-
-            if (!astr.validPosition()) {
-                astr.setState();
-            }
-        }
-        repaint();
-    }
+    void advanceFrame() {
 
-    void return_to_main_menu() {
-        stacked_widget->setCurrentIndex(0);
-    }
+        ScopedTimer timer(&profiler, Profiler::FRAME);
+        uint64_t allocations = allocation_count();
 
-    /**
-     * @brief moveAttack
-     * This function handles the animation of the attack image.
-     */
-    void moveAttack() {
+        qint64 elapsed = frameClock.nsecsElapsed();
+        frameClock.restart();
+        profiler.record(Profiler::FRAME_JITTER, std::abs(elapsed - FRAME_INTERVAL * 1000000LL));
 
-        if(attackLabel == nullptr) {
-            set_up_attack();
+        SnapshotBuffer& snapshots = simulation.snapshots();
+        if(snapshots.update()) {
+            snapshotClock.restart();
+        }
+        const Snapshot& snapshot = snapshots.front();
+
+        if(snapshot.over) {
+            reset_gameboard();
+            show_page(create_gameover_screen());
+            setFixedSize(475,400);
+            emit game_over();
+            return;
         }
 
-        if(isAttacking && is_attack_in_valid_range()) {
-            attackX = attackX + attackXDirection;
-            attackY = attackY + attackYDirection;
-            grid->addWidget(attackLabel, attackX, attackY, 1, 1, Qt::AlignCenter);
-            for(auto& x : astVec) {
-
-                /** If the coordinates of the attack image equal the coordinates of an asteroid,
-                 *  we want to remove the attack image, restart the asteroid, and exit the function
-                  */
-                if(attackX == x.getX() && attackY == x.getY()) {
-                    reset_attack();
-                    x.setState();
-                    num_asteroids_hit++;
-                    return;
-                }
-            }
-        } else if (isAttacking && !is_attack_in_valid_range()) {
-            reset_attack();
+        double since = std::min(snapshotClock.nsecsElapsed() / 1e6 * loop.time_scale(), (double)loop.tick_length());
+        gameBoard->show_snapshot(&snapshot, snapshot.elapsed + since);
+        shownInput = snapshot.input_time;
+
+        if(capture != nullptr) {
+            capture->capture(snapshot, snapshot.elapsed + since);
         }
+
+        profiler.record(Profiler::ALLOCATIONS, allocation_count() - allocations);
     }
 
-    void increase_num_asteroids() {
-        astVec.push_back(Asteroid());
-        NUMASTEROIDS++;
+    void return_to_main_menu() {
+        stacked_widget->setCurrentIndex(0);
     }
 
+    void board_painted();
+
+signals:
+    void game_over();
+
 public:
+    static const int DEFAULT_VIEW = 23;
+    static const int DEFAULT_BOARD_SIZE = 575;
+
     explicit MainWindow(QWidget *parent = 0);
     QWidget* createGameBoard();
     QWidget* create_gameover_screen();
-    void paintEvent(QPaintEvent* e);
     void keyPressEvent(QKeyEvent* e);
-    void rotateShip();
-    bool collided_with_attack(const Asteroid& a) const;
+    void set_grid_size(int size);
+    void set_time_scale(double scale);
+    void set_record_path(const std::string& path);
+    bool set_score_path(const std::string& path);
+    static std::string default_score_path();
+    void set_capture(FrameCapture* capture);
     ~MainWindow();
 
     int GRIDWIDTH;
     int GRIDLENGTH;
+    int VIEWWIDTH;
+    int VIEWLENGTH;
     int BOARDWIDTH;
     int BOARDHEIGHT;
 
@@ -127,55 +132,59 @@ public:
     int SIZE_OF_ASTEROID;
     int ASTEROID_SPEED;
     int RATE_OF_NUM_ASTR_INCREASE;
+    int ASTEROID_FRAGMENTS;
+    bool ASTEROID_COLLISIONS;
 
     int TOP_LEFT_XCORD_SHIP;
     int TOP_LEFT_YCORD_SHIP;
     int SIZE_OF_SHIP;
     int ATTACK_SPEED;
 
+    int FRAME_INTERVAL;
+
 private:
     Ui::MainWindow *ui;
 
     QStackedWidget* stacked_widget;
     QWidget* central;
 
-    bool shipDiagonal;
-    size_t shipCurrentRotation;
-    QImage shipImage;
-    QImage shipImageRotated;
-    QPixmap shipPixmap;
-    QLabel* shipLabel;
-
-    void set_up_attack();
-    bool is_attack_in_valid_range();
-    QLabel* attackLabel;
-    bool isAttacking;
-    int attackX;
-    int attackY;
-    int attackXDirection;
-    int attackYDirection;
-
-    QTimer* attackTimer;
-    QTimer* asteroidTimer;
-    QTimer* increase_number_of_asteroids_timer;
-
-    QWidget* gameBoard;
-    QLabel** gridLabels;
-    QGridLayout* grid;
-
-    std::vector<Asteroid> astVec;
-    void set_up_asteroids();
+    World world;
+    GameLoop loop;
+    Profiler profiler;
+    Simulation simulation;
+
+    void apply_input(World::Input input);
+    Recording recording;
+    std::string recordPath;
+    FrameCapture* capture;
+
+    ScoreLog scores;
+    QTextEdit* highScores;
+
+    QTimer* frameTimer;
+    QElapsedTimer frameClock;
+    QElapsedTimer snapshotClock;
+
+    qint64 startupTime;
+    QElapsedTimer gameStartClock;
+    bool firstFramePending;
+    qint64 firstFrameTime;
+
+    long long shownInput;
+    long long measuredInput;
+
+    BoardWidget* gameBoard;
 
     void reset_gameboard();
-    void reset_attack();
+    void show_page(QWidget* page);
+    void show_high_scores();
 
     //gameover screen section
     QWidget* gameover_screen;
     QVBoxLayout* gameover_layout;
     QLabel* score;
     QLabel* gameover_banner;
-    size_t num_asteroids_hit;
-    size_t num_shots_fired;
+    QLabel* timings;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,101 @@
+/** @file spritecache.cpp
+ *  @brief This file contains the definition of the SpriteCache class.
+ */
+
+#include "spritecache.h"
+
+#include <algorithm>
+
+#include <QImage>
+#include <QTransform>
+
+/**
+ * @brief SpriteCache::shared gets the sprites of the game. The images are decoded the first time
+ * this function is called, so it must not be called before the QApplication exists.
+ * @return a reference to the sprites
+ */
+const SpriteCache& SpriteCache::shared() {
+    static const SpriteCache cache;
+    return cache;
+}
+
+/**
+ * @brief SpriteCache::SpriteCache decodes the images, shrinks the asteroid for its fragments and renders the ship in
+ * each of its eight orientations.
+ * The function takes advantage of the fact that only eight orientations of the ship are possible. The cardinal
+ * directions (N, S, E, W) rotate spaceship.png and the diagonals (NW, SW, SE, NE) rotate spaceshipRotated.png,
+ * always by a multiple of 90 degrees.
+ */
+SpriteCache::SpriteCache() {
+    asteroidSizes[0] = QPixmap(":/images/asteroid.png");
+    for(int level = 1; level < NUM_ASTEROID_SIZES; ++level) {
+        asteroidSizes[level] = asteroidSizes[0].scaled(asteroidSizes[0].size() / (1 << level), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    attackPixmap = QPixmap(":/images/attack.png");
+
+    QImage shipImage(":/images/spaceship.png");
+    QImage shipImageRotated(":/images/spaceshipRotated.png");
+
+    for(int i = 0; i < NUM_SHIP_FRAMES; ++i) {
+        int rotation = i * 45;
+        QTransform trans;
+
+        if(rotation % 90 != 0) {
+            trans.rotate(rotation - 45);
+            shipFrames[i] = QPixmap::fromImage(shipImageRotated.transformed(trans));
+        }
+        else {
+            trans.rotate(rotation);
+            shipFrames[i] = QPixmap::fromImage(shipImage.transformed(trans));
+        }
+    }
+}
+
+/**
+ * @brief SpriteCache::scaled makes a copy of the sprites in which every image is scaled to the same size.
+ * @param size is the size of the scaled images
+ * @return the scaled sprites
+ */
+SpriteCache SpriteCache::scaled(const QSize& size) const {
+    SpriteCache copy(*this);
+
+    if(size.isEmpty()) {
+        return copy;
+    }
+
+    for(int level = 0; level < NUM_ASTEROID_SIZES; ++level) {
+        copy.asteroidSizes[level] = asteroidSizes[0].scaled(size / (1 << level), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    copy.attackPixmap = attackPixmap.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    for(int i = 0; i < NUM_SHIP_FRAMES; ++i) {
+        copy.shipFrames[i] = shipFrames[i].scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return copy;
+}
+
+/**
+ * @brief SpriteCache::asteroid gets the image of an asteroid or of one of its fragments, half the size for each level
+ * @param level is how many times the asteroid broke up; levels past the smallest image use the smallest image
+ * @return the asteroid image
+ */
+const QPixmap& SpriteCache::asteroid(int level) const {
+    return asteroidSizes[std::max(0, std::min(level, NUM_ASTEROID_SIZES - 1))];
+}
+
+/**
+ * @brief SpriteCache::attack gets the image of the attack
+ * @return the attack image
+ */
+const QPixmap& SpriteCache::attack() const {
+    return attackPixmap;
+}
+
+/**
+ * @brief SpriteCache::ship gets the image of the ship in one of its orientations
+ * @param rotation is the rotation of the ship in degrees, clockwise from north
+ * @return the ship image
+ */
+const QPixmap& SpriteCache::ship(size_t rotation) const {
+    return shipFrames[(rotation % 360) / 45];
+}
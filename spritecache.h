@@ -0,0 +1,39 @@
+/** @file spritecache.h
+ *  @brief Class declaration for the SpriteCache class. Holds every image of the game, decoded once.
+ */
+
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <cstddef>
+
+#include <QPixmap>
+#include <QSize>
+
+/**
+ * @brief The SpriteCache class decodes the images in res.qrc once and pre-renders the eight orientations
+ * of the ship and the fragments of an asteroid, so that neither spawning an asteroid, breaking it up nor rotating the
+ * ship decodes or transforms an image.
+ */
+class SpriteCache {
+public:
+    static const int NUM_SHIP_FRAMES = 8;
+    static const int NUM_ASTEROID_SIZES = 3;
+
+    static const SpriteCache& shared();
+
+    SpriteCache scaled(const QSize& size) const;
+
+    const QPixmap& asteroid(int level) const;
+    const QPixmap& attack() const;
+    const QPixmap& ship(size_t rotation) const;
+
+private:
+    SpriteCache();
+
+    QPixmap asteroidSizes[NUM_ASTEROID_SIZES];
+    QPixmap attackPixmap;
+    QPixmap shipFrames[NUM_SHIP_FRAMES];
+};
+
+#endif // SPRITECACHE_H
@@ -0,0 +1,100 @@
+/** @file asteroidfieldtest.cpp
+ *  @brief Tests of the AsteroidField class and of the kernels which move the asteroids.
+ */
+
+#include "check.h"
+#include "asteroidfield.h"
+#include "asteroidkernel.h"
+#include "rng.h"
+
+#include <vector>
+
+/**
+ * @brief The Sides struct counts the asteroids that entered from each side of the gameboard,
+ * and how many of them are still on it after their first step.
+ */
+struct Sides {
+    int entered[4];
+    int stayed[4];
+};
+
+/**
+ * @brief count_sides spawns asteroids on a gameboard and moves them one step with a kernel. Only the asteroids whose
+ * tile along their side is neither the first nor the last are counted, since the others may leave along the side.
+ * @param rows is the number of rows of the gameboard
+ * @param cols is the number of columns of the gameboard
+ * @param kernel is the kernel to move the asteroids with
+ * @return the count for the top, the left, the bottom and the right
+ */
+static Sides count_sides(int rows, int cols, decltype(&step_asteroids) kernel) {
+    const size_t n = 4000;
+
+    AsteroidField field;
+    field.set_board(rows, cols);
+    field.set_speed(600, 10, 25);
+    Rng rng(7);
+    field.spawn_wave(n, rng);
+
+    std::vector<int> fx(n), fy(n), x(n), y(n), xVel(n), yVel(n);
+    for(size_t i = 0; i < n; ++i) {
+        fx[i] = field.getFixedX(i);
+        fy[i] = field.getFixedY(i);
+        x[i] = field.getX(i);
+        y[i] = field.getY(i);
+        xVel[i] = field.getXvel(i);
+        yVel[i] = field.getYvel(i);
+    }
+
+    AsteroidField::Bounds bounds;
+    bounds.max_x = rows - 1;
+    bounds.max_y = cols - 1;
+    bounds.ship_x = -10;
+    bounds.ship_y = -10;
+
+    std::vector<unsigned char> respawn((n + 7) / 8), crossed((n + 7) / 8);
+    kernel(fx.data(), fy.data(), x.data(), y.data(), xVel.data(), yVel.data(), n, bounds, respawn.data(), crossed.data());
+
+    Sides sides = {};
+    for(size_t i = 0; i < n; ++i) {
+        int sx = field.getX(i);
+        int sy = field.getY(i);
+        int side = -1;
+        if(sx == 0 && xVel[i] > 0 && sy > 0 && sy < cols - 1) {
+            side = 0;
+        } else if(sy == 0 && yVel[i] > 0 && sx > 0 && sx < rows - 1) {
+            side = 1;
+        } else if(sx == rows - 1 && xVel[i] < 0 && sy > 0 && sy < cols - 1) {
+            side = 2;
+        } else if(sy == cols - 1 && yVel[i] < 0 && sx > 0 && sx < rows - 1) {
+            side = 3;
+        }
+        if(side != -1) {
+            ++sides.entered[side];
+            sides.stayed[side] += !(respawn[i >> 3] & (1 << (i & 7)));
+        }
+    }
+    return sides;
+}
+
+/**
+ * @brief test_spawn_sides checks that the asteroids entering from each of the four sides of the gameboard are still
+ * on it after their first step, when they move a fraction of a tile per step. Every kernel is checked, on the
+ * gameboard of the game and on one that has no FixedBoard.
+ */
+void test_spawn_sides(Check& check) {
+    std::vector<decltype(&step_asteroids)> kernels = { step_asteroids, step_asteroids_generic, step_asteroids_scalar };
+    if(avx2_supported()) {
+        kernels.push_back(step_asteroids_avx2);
+    }
+
+    const int sizes[][2] = { { 23, 23 }, { 40, 31 } };
+    for(const auto& size : sizes) {
+        for(auto kernel : kernels) {
+            Sides sides = count_sides(size[0], size[1], kernel);
+            for(int side = 0; side < 4; ++side) {
+                CHECK(check, sides.entered[side] > 0);
+                CHECK(check, sides.stayed[side] == sides.entered[side]);
+            }
+        }
+    }
+}
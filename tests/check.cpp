@@ -0,0 +1,49 @@
+/** @file check.cpp
+ *  @brief This file contains the definition of the Check class.
+ */
+
+#include "check.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include <unistd.h>
+
+/**
+ * @brief Check::Check constructs a check with no failures.
+ */
+Check::Check() : failed(0) {
+}
+
+/**
+ * @brief Check::expect records one check, and reports it if it failed
+ * @param ok is the outcome of the check
+ * @param condition is the text of the condition checked
+ * @param file is the source file of the check
+ * @param line is the line of the check
+ */
+void Check::expect(bool ok, const char* condition, const char* file, int line) {
+    if(!ok) {
+        ++failed;
+        std::cerr << file << ":" << line << ": check failed: " << condition << std::endl;
+    }
+}
+
+/**
+ * @brief Check::failures gets the number of failed checks
+ * @return the number of checks that failed
+ */
+int Check::failures() const {
+    return failed;
+}
+
+/**
+ * @brief temp_path makes the name of a file in the temporary directory that no other run of the tests uses
+ * @param name is the name of the file, unique within the tests
+ * @return the path of the file
+ */
+std::string temp_path(const char* name) {
+    const char* dir = std::getenv("TMPDIR");
+    return std::string(dir != nullptr && *dir != '\0' ? dir : "/tmp") + "/asteroids_tests_"
+            + std::to_string(getpid()) + "_" + name;
+}
@@ -0,0 +1,39 @@
+/** @file check.h
+ *  @brief Class declaration for the Check class, which counts the failed checks of the tests, and the declarations
+ *         of the tests and of their helpers.
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <string>
+
+/**
+ * @brief The Check class records the outcome of the checks made by one test. A failed check is reported with its
+ * condition and its location right away, and the test goes on.
+ */
+class Check {
+public:
+    Check();
+
+    void expect(bool ok, const char* condition, const char* file, int line);
+    int failures() const;
+
+private:
+    int failed;
+};
+
+#define CHECK(check, condition) (check).expect((condition), #condition, __FILE__, __LINE__)
+
+std::string temp_path(const char* name);
+
+void test_spawn_sides(Check& check);
+void test_replay_checked_in(Check& check);
+void test_replay_roundtrip(Check& check);
+void test_scorelog_truncated(Check& check);
+void test_scorelog_torn(Check& check);
+void test_scorelog_refuses(Check& check);
+void test_state_roundtrip(Check& check);
+void test_state_corrupted(Check& check);
+
+#endif // CHECK_H
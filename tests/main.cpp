@@ -0,0 +1,40 @@
+/** @file main.cpp
+ *  @brief Runs every test of the simulation core and prints one line per test. Exits with 0 when every test
+ *         passed and 1 otherwise.
+ */
+
+#include "check.h"
+
+#include <iostream>
+
+/**
+ * @brief The Test struct names a test.
+ */
+struct Test {
+    const char* name;
+    void (*run)(Check& check);
+};
+
+static const Test TESTS[] = {
+    { "spawn_sides", test_spawn_sides },
+    { "replay_checked_in", test_replay_checked_in },
+    { "replay_roundtrip", test_replay_roundtrip },
+    { "scorelog_truncated", test_scorelog_truncated },
+    { "scorelog_torn", test_scorelog_torn },
+    { "scorelog_refuses", test_scorelog_refuses },
+    { "state_roundtrip", test_state_roundtrip },
+    { "state_corrupted", test_state_corrupted }
+};
+
+int main() {
+    int failures = 0;
+
+    for(const Test& test : TESTS) {
+        Check check;
+        test.run(check);
+        std::cout << (check.failures() == 0 ? "PASS " : "FAIL ") << test.name << std::endl;
+        failures += check.failures();
+    }
+
+    return failures == 0 ? 0 : 1;
+}
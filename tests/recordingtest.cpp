@@ -0,0 +1,78 @@
+/** @file recordingtest.cpp
+ *  @brief Tests of the Recording class: a checked-in recording still replays to its recorded score, and games
+ *         recorded now replay exactly.
+ */
+
+#include "check.h"
+#include "recording.h"
+#include "bot.h"
+
+#include <cstdio>
+
+/**
+ * @brief record_game lets a RandomBot play a game with the default settings and records it. The bot is asked three
+ * milliseconds into every tick, so the inputs fall between the ticks as they do in the game.
+ * @param seed is the seed of the game and of the bot
+ * @param recording is set to the recorded game
+ */
+static void record_game(uint64_t seed, Recording& recording) {
+    const int tick_length = 10;
+    const long long max_ticks = 30000;
+
+    World::Settings settings;
+    settings.seed = seed;
+    World world(settings);
+    RandomBot bot;
+    bot.reset(seed);
+    recording.start(settings, tick_length);
+
+    long long ticks = 0;
+    while(!world.is_over() && ticks < max_ticks) {
+        world.step(3);
+        World::Input input;
+        if(!world.is_over() && bot.press(world, input)) {
+            world.apply(input);
+            recording.record(world.elapsed(), input);
+        }
+        world.step(tick_length - 3);
+        ++ticks;
+    }
+    recording.finish(world, ticks);
+}
+
+/**
+ * @brief test_replay_checked_in replays the recording kept with the tests, which was recorded with record_game() and the seed 2016.
+ * A change to the rules of the game that makes it play out differently is caught here.
+ */
+void test_replay_checked_in(Check& check) {
+    Recording recording;
+    CHECK(check, recording.load(TEST_DATA_DIR "/randombot.rec"));
+    CHECK(check, recording.events().size() > 100);
+
+    World world;
+    CHECK(check, recording.replay(world));
+    CHECK(check, world.num_asteroids_hit() > 0);
+}
+
+/**
+ * @brief test_replay_roundtrip records games of many seeds, saves and loads each recording and checks that the
+ * replay ends with the same score after the same number of ticks.
+ */
+void test_replay_roundtrip(Check& check) {
+    std::string path = temp_path("roundtrip.rec");
+
+    for(uint64_t seed = 1; seed <= 40; ++seed) {
+        Recording recorded;
+        record_game(seed, recorded);
+        CHECK(check, recorded.save(path));
+
+        Recording loaded;
+        CHECK(check, loaded.load(path));
+        CHECK(check, loaded.events().size() == recorded.events().size());
+
+        World world;
+        CHECK(check, loaded.replay(world));
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,165 @@
+/** @file scorelogtest.cpp
+ *  @brief Tests of the ScoreLog class: a log that was cut short or only partly written is recovered on the next open.
+ */
+
+#include "check.h"
+#include "scorelog.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <unistd.h>
+
+static const long HEADER_SIZE = 4096;
+static const long RECORD_SIZE = sizeof(ScoreLog::Score) + sizeof(uint64_t);
+
+/**
+ * @brief make_score makes the score of a game
+ * @param i numbers the game; the games with a larger number destroyed more asteroids
+ * @return the score
+ */
+static ScoreLog::Score make_score(uint32_t i) {
+    ScoreLog::Score score;
+    score.time = 1000 + i;
+    score.seed = i;
+    score.elapsed = 10 * i;
+    score.asteroids_hit = i * 7 % 13;
+    score.shots_fired = i;
+    return score;
+}
+
+/**
+ * @brief write_log makes a new log at path holding the scores of the games 0 to n - 1
+ * @return false if the log could not be written
+ */
+static bool write_log(const std::string& path, uint32_t n) {
+    std::remove(path.c_str());
+    ScoreLog log;
+    if(!log.open(path)) {
+        return false;
+    }
+    for(uint32_t i = 0; i < n; ++i) {
+        if(!log.append(make_score(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief poke overwrites one byte of a file
+ */
+static void poke(const std::string& path, long offset, char value) {
+    std::fstream file(path.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(offset);
+    file.put(value);
+}
+
+/**
+ * @brief best_of ranks the scores of the games 0 to n - 1 the way a log does
+ * @return the TOP_K best scores, the best first
+ */
+static std::vector<ScoreLog::Score> best_of(uint32_t n) {
+    std::vector<ScoreLog::Score> all;
+    for(uint32_t i = 0; i < n; ++i) {
+        all.push_back(make_score(i));
+    }
+    std::stable_sort(all.begin(), all.end(), ScoreLog::better);
+    all.resize(std::min(all.size(), (size_t)ScoreLog::TOP_K));
+    return all;
+}
+
+/**
+ * @brief same_scores compares the best scores of a log with the expected ones
+ */
+static bool same_scores(const std::vector<ScoreLog::Score>& a, const std::vector<ScoreLog::Score>& b) {
+    if(a.size() != b.size()) {
+        return false;
+    }
+    for(size_t i = 0; i < a.size(); ++i) {
+        if(a[i].seed != b[i].seed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief test_scorelog_truncated cuts a log short in the middle of a score. The scores before the cut are kept,
+ * the best scores are ranked again from them, and scores can be appended after them.
+ */
+void test_scorelog_truncated(Check& check) {
+    std::string path = temp_path("truncated.log");
+    CHECK(check, write_log(path, 40));
+    CHECK(check, truncate(path.c_str(), HEADER_SIZE + 25 * RECORD_SIZE + RECORD_SIZE / 2) == 0);
+
+    ScoreLog log;
+    CHECK(check, log.open(path));
+    CHECK(check, log.size() == 25);
+    CHECK(check, same_scores(log.top(), best_of(25)));
+
+    CHECK(check, log.append(make_score(25)));
+    log.close();
+    CHECK(check, log.open(path));
+    CHECK(check, log.size() == 26);
+    CHECK(check, same_scores(log.top(), best_of(26)));
+
+    log.close();
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief test_scorelog_torn tears the last score of a log, as a crash while it was appended does, then the first page.
+ * A torn score ends the log, and a torn first page is rebuilt from the scores.
+ */
+void test_scorelog_torn(Check& check) {
+    std::string path = temp_path("torn.log");
+    CHECK(check, write_log(path, 30));
+    poke(path, HEADER_SIZE + 29 * RECORD_SIZE + 3, 0x5a);
+
+    ScoreLog log;
+    CHECK(check, log.open(path));
+    CHECK(check, log.size() == 29);
+    CHECK(check, same_scores(log.top(), best_of(29)));
+    CHECK(check, log.append(make_score(29)));
+    log.close();
+
+    poke(path, 40, 0x5a);
+    CHECK(check, log.open(path));
+    CHECK(check, log.size() == 30);
+    CHECK(check, log.at(29).seed == 29);
+    CHECK(check, same_scores(log.top(), best_of(30)));
+
+    log.close();
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief test_scorelog_refuses checks that a file too short to be a log is left untouched, and that a log another
+ * ScoreLog has open is not opened a second time.
+ */
+void test_scorelog_refuses(Check& check) {
+    std::string path = temp_path("refuses.log");
+    {
+        std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+        file << "not a score log";
+    }
+
+    ScoreLog log;
+    CHECK(check, !log.open(path));
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    CHECK(check, file.tellg() == 15);
+
+    CHECK(check, write_log(path, 3));
+    CHECK(check, log.open(path));
+    ScoreLog other;
+    CHECK(check, !other.open(path));
+    log.close();
+    CHECK(check, other.open(path));
+    CHECK(check, other.size() == 3);
+
+    other.close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# Tests of the simulation core. Run with make check, or run the
+# executable, which exits with 1 if a check failed.
+#
+#-------------------------------------------------
+
+CONFIG   -= qt app_bundle
+CONFIG   += c++14 console testcase
+
+TARGET = asteroids_tests
+TEMPLATE = app
+
+SOURCES += main.cpp \
+    check.cpp \
+    asteroidfieldtest.cpp \
+    recordingtest.cpp \
+    scorelogtest.cpp \
+    worldstatetest.cpp
+
+HEADERS += check.h
+
+DEFINES += TEST_DATA_DIR=\\\"$$PWD/data\\\"
+
+include(../core/core.pri)
@@ -0,0 +1,155 @@
+/** @file worldstatetest.cpp
+ *  @brief Tests of World::save_state() and World::restore_state(): a restored game plays on exactly as the game it
+ *         was saved from, and blocks no game can produce are rejected.
+ */
+
+#include "check.h"
+#include "world.h"
+#include "bot.h"
+
+#include <cstring>
+#include <vector>
+
+static const size_t HEADER_SIZE = 160;
+static const size_t GRID_WIDTH = 32;
+static const size_t ASTEROID_STEP = 48;
+static const size_t RNG = 96;
+
+/**
+ * @brief play lets a bot play a world for a number of ticks of ten milliseconds, or until the game is over
+ */
+static void play(World& world, RandomBot& bot, int ticks) {
+    for(int t = 0; t < ticks && !world.is_over(); ++t) {
+        World::Input input;
+        if(bot.press(world, input)) {
+            world.apply(input);
+        }
+        world.step(10);
+    }
+}
+
+/**
+ * @brief test_state_roundtrip saves games of many seeds part way through, restores each into another world and lets
+ * copies of the same bot play both on. The two games must end in the same state. The state of a game that is over
+ * must be restored as well.
+ */
+void test_state_roundtrip(Check& check) {
+    for(uint64_t seed = 1; seed <= 40; ++seed) {
+        World::Settings settings;
+        settings.seed = seed;
+        settings.asteroid_fragments = (int)(seed % 4);
+        settings.asteroid_collisions = seed % 2 == 0;
+
+        World world(settings);
+        RandomBot bot;
+        bot.reset(seed);
+        play(world, bot, (int)(seed * 37));
+
+        std::vector<unsigned char> saved;
+        world.save_state(saved);
+        CHECK(check, saved.size() == world.state_size());
+
+        World restored;
+        CHECK(check, restored.restore_state(saved));
+        RandomBot copy = bot;
+
+        play(world, bot, 20000);
+        play(restored, copy, 20000);
+
+        std::vector<unsigned char> a, b;
+        world.save_state(a);
+        restored.save_state(b);
+        CHECK(check, a == b);
+        CHECK(check, world.num_asteroids_hit() == restored.num_asteroids_hit());
+        CHECK(check, world.elapsed() == restored.elapsed());
+
+        World after;
+        CHECK(check, after.restore_state(a));
+        CHECK(check, after.is_over() == world.is_over());
+    }
+}
+
+/**
+ * @brief rejected checks that a world refuses a block and is left as it was
+ * @return true if the block was rejected and the world did not change
+ */
+static bool rejected(World& world, const std::vector<unsigned char>& block) {
+    std::vector<unsigned char> before, after;
+    world.save_state(before);
+    bool restored = world.restore_state(block);
+    world.save_state(after);
+    return !restored && before == after;
+}
+
+/**
+ * @brief put_int writes an int into a block at an offset
+ */
+static void put_int(std::vector<unsigned char>& block, size_t offset, int value) {
+    std::memcpy(&block[offset], &value, sizeof(value));
+}
+
+/**
+ * @brief test_state_corrupted feeds a world blocks whose header or asteroids were corrupted: a gameboard that is too
+ * small, a period of zero, a generator state of zero, an asteroid off the gameboard, an asteroid faster than a tile
+ * per step and an asteroid broken up more than AsteroidField::MAX_LEVEL times. Each is rejected.
+ */
+void test_state_corrupted(Check& check) {
+    World::Settings settings;
+    settings.seed = 5;
+    World source(settings);
+    RandomBot bot;
+    bot.reset(5);
+    play(source, bot, 300);
+    CHECK(check, !source.is_over());
+
+    std::vector<unsigned char> good;
+    source.save_state(good);
+    size_t n = source.asteroids().size();
+    size_t shots = source.projectiles().size();
+    CHECK(check, n > 0);
+    CHECK(check, good.size() == HEADER_SIZE + n * (4 * sizeof(int) + 1) + shots * 4 * sizeof(int));
+
+    World world;
+    CHECK(check, world.restore_state(good));
+    world.step(10);
+
+    std::vector<unsigned char> block = good;
+    put_int(block, GRID_WIDTH, 0);
+    CHECK(check, rejected(world, block));
+
+    block = good;
+    put_int(block, ASTEROID_STEP, 0);
+    CHECK(check, rejected(world, block));
+
+    block = good;
+    std::memset(&block[RNG], 0, sizeof(uint64_t));
+    CHECK(check, rejected(world, block));
+
+    const size_t bytes = n * sizeof(int);
+    const int out = (settings.grid_length + 5) * AsteroidField::ONE_TILE;
+    for(size_t i = 0; i < n; i += n - 1) {
+        block = good;
+        put_int(block, HEADER_SIZE + i * sizeof(int), out);
+        CHECK(check, rejected(world, block));
+
+        block = good;
+        put_int(block, HEADER_SIZE + bytes + i * sizeof(int), -2 * AsteroidField::ONE_TILE);
+        CHECK(check, rejected(world, block));
+
+        block = good;
+        put_int(block, HEADER_SIZE + 2 * bytes + i * sizeof(int), AsteroidField::ONE_TILE + 1);
+        CHECK(check, rejected(world, block));
+
+        block = good;
+        put_int(block, HEADER_SIZE + 3 * bytes + i * sizeof(int), -AsteroidField::ONE_TILE - 1);
+        CHECK(check, rejected(world, block));
+
+        block = good;
+        block[HEADER_SIZE + 4 * bytes + i] = AsteroidField::MAX_LEVEL + 1;
+        CHECK(check, rejected(world, block));
+
+        if(n == 1) {
+            break;
+        }
+    }
+}